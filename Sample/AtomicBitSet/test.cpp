@@ -0,0 +1,152 @@
+﻿#include "Eterfree/Core/AtomicBitSet.hpp"
+#include "Eterfree/Core/BitSet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+USING_ETERFREE_SPACE
+
+using SizeType = std::size_t;
+
+// 多线程同时占用，每个位恰好被占用一次
+template <bool _PADDED>
+static bool verify(SizeType _threads)
+{
+	constexpr SizeType CAPACITY = 10007;
+
+	AtomicBitSet<std::uint64_t, _PADDED> bitSet(CAPACITY);
+	std::vector<std::vector<SizeType>> claimed(_threads);
+
+	std::vector<std::thread> threads;
+	for (SizeType index = 0; index < _threads; ++index)
+		threads.emplace_back([&bitSet, &claimed, index, _threads]
+			{
+				auto hint = CAPACITY / _threads * index;
+				for (SizeType position; \
+					(position = bitSet.claim(hint)) != bitSet.NPOS; \
+					hint = position)
+					claimed[index].push_back(position);
+			});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	std::vector<bool> seen(CAPACITY);
+	for (auto& positions : claimed)
+		for (auto position : positions)
+		{
+			if (position >= CAPACITY or seen[position])
+				return false;
+			seen[position] = true;
+		}
+
+	for (SizeType position = 0; position < CAPACITY; ++position)
+		if (not seen[position]) return false;
+
+	if (not bitSet.all() or bitSet.claim() != bitSet.NPOS)
+		return false;
+
+	// 释放后可再次占用
+	if (not bitSet.release(4321) or bitSet.release(4321) \
+		or bitSet.claim() != 4321)
+		return false;
+
+	if (bitSet.reset(100, 9000) != 8900 or bitSet.count() != CAPACITY - 8900)
+		return false;
+
+	if (bitSet.set(0, CAPACITY) != 8900 or bitSet.flip(64, 200) != 136)
+		return false;
+
+	if (bitSet.exist(63) != true or bitSet.exist(64) != false \
+		or bitSet.testAndSet(64) or not bitSet.testAndReset(64) \
+		or bitSet.testAndFlip(64) or not bitSet[64])
+		return false;
+
+	bitSet.reset();
+	return bitSet.none();
+}
+
+// 每线程反复占用与释放
+template <typename _Claim, typename _Release>
+static double benchmark(SizeType _threads, \
+	_Claim&& _claim, _Release&& _release)
+{
+	constexpr SizeType ROUNDS = 1 << 20;
+
+	auto begin = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (SizeType index = 0; index < _threads; ++index)
+		threads.emplace_back([&_claim, &_release, index]
+			{
+				for (SizeType round = 0; round < ROUNDS; ++round)
+					_release(_claim(index));
+			});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	std::chrono::duration<double> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return _threads * ROUNDS / duration.count() / 1e6;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	auto cores = std::thread::hardware_concurrency();
+	if (cores <= 0) cores = 1;
+
+	SizeType threads = cores < 4 ? 4 : cores;
+	cout << std::boolalpha \
+		<< "packed verify " << verify<false>(threads) << endl \
+		<< "padded verify " << verify<true>(threads) << endl;
+
+	constexpr SizeType CAPACITY = 4096;
+
+	std::mutex mutex;
+	BitSet<std::uint64_t> bitSet(CAPACITY);
+	AtomicBitSet<std::uint64_t> packed(CAPACITY);
+	AtomicBitSet<std::uint64_t, true> padded(CAPACITY);
+
+	cout << endl;
+	for (SizeType threads = 1; threads <= cores; threads <<= 1)
+	{
+		// 各线程自不同区域起步
+		auto stride = CAPACITY / threads;
+
+		auto locked = benchmark(threads, \
+			[&](SizeType _index)
+			{
+				std::lock_guard lock(mutex);
+				auto position = bitSet.find(stride * _index, false);
+				bitSet.set(position);
+				return position;
+			}, \
+			[&](SizeType _position)
+			{
+				std::lock_guard lock(mutex);
+				bitSet.reset(_position);
+			});
+
+		auto atomic = benchmark(threads, \
+			[&](SizeType _index) { return packed.claim(stride * _index); }, \
+			[&](SizeType _position) { packed.release(_position); });
+
+		auto aligned = benchmark(threads, \
+			[&](SizeType _index) { return padded.claim(stride * _index); }, \
+			[&](SizeType _position) { padded.release(_position); });
+
+		cout << threads << " threads: mutex " << locked \
+			<< " packed " << atomic << " padded " << aligned \
+			<< " M ops/s" << endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+﻿#include "Eterfree/Core/BitParallel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+USING_ETERFREE_SPACE
+
+using BitSetType = BitSet<std::uint64_t>;
+using SizeType = BitSetType::SizeType;
+
+static BitSetType generate(std::mt19937_64& _engine, SizeType _size)
+{
+	std::vector<BitSetType::ValueType> vector(_size);
+	for (auto& element : vector)
+		element = _engine();
+	return BitSetType(vector.data(), vector.size());
+}
+
+// 以极小分区强制多线程，与串行实现比较，覆盖跨分区之移位与复制
+static bool verify(std::mt19937_64& _engine)
+{
+	for (SizeType threads : { 1, 2, 3, 8 })
+	{
+		BitParallel parallel(threads, BitParallel::ALIGNMENT);
+		for (SizeType size : { 1, 7, 8, 9, 64, 1000 })
+		{
+			auto bitSetA = generate(_engine, size);
+			auto bitSetB = generate(_engine, size + 3);
+
+			if (parallel.count(bitSetA) != bitSetA.count() \
+				or parallel.count(bitSetA ^ ~bitSetB) \
+				!= (bitSetA ^ ~bitSetB).count())
+				return false;
+
+			BitSetType result(bitSetA), expected(bitSetA);
+			parallel.assign(result, result & bitSetB);
+			if (result != (expected &= bitSetB)) return false;
+
+			parallel.assign(result, (result | bitSetB) ^ bitSetA);
+			expected = (expected | bitSetB) ^ bitSetA;
+			if (result != expected or result.size() != expected.size())
+				return false;
+
+			auto bits = size * 64;
+			for (SizeType position : { SizeType(1), SizeType(63), \
+				SizeType(64), SizeType(65), bits / 3, bits - 1, bits + 5 })
+			{
+				BitSetType left(bitSetA), right(bitSetA);
+				if (parallel.shiftLeft(left, position) != (bitSetA << position) \
+					or parallel.shiftRight(right, position) != (bitSetA >> position))
+					return false;
+
+				auto end = position + bits / 2 + 1;
+				auto copy = parallel.copy(bitSetA, position, end);
+				if (copy != bitSetA.copy(position, end) \
+					or copy.size() != bitSetA.copy(position, end).size())
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <typename _Functor>
+static double measure(_Functor _functor)
+{
+	constexpr auto ROUNDS = 8;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (auto round = 0; round < ROUNDS; ++round)
+		_functor();
+
+	std::chrono::duration<double, std::milli> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return duration.count() / ROUNDS;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	std::mt19937_64 engine(0);
+	cout << std::boolalpha << "verify " << verify(engine) << endl << endl;
+
+	// 二的二十八次方位，三十二兆字节
+	constexpr SizeType SIZE = SizeType(1) << 22;
+	constexpr SizeType POSITION = 12345;
+
+	auto bitSetA = generate(engine, SIZE);
+	auto bitSetB = generate(engine, SIZE);
+	auto bitSet = bitSetA, slice = bitSetA;
+
+	SizeType expected = 0, result = 0;
+	auto count = measure([&] { expected = bitSetA.count(); });
+	auto assign = measure([&] { bitSet = bitSetA ^ bitSetB; });
+	auto shift = measure([&] { bitSet <<= POSITION; });
+	auto copy = measure([&] { slice = bitSetA.copy(POSITION, SIZE * 32); });
+	cout << "serial: count " << count << " ms, xor " << assign \
+		<< " ms, shift " << shift << " ms, copy " << copy << " ms" << endl;
+
+	auto cores = std::thread::hardware_concurrency();
+	if (cores <= 0) cores = 1;
+
+	for (decltype(cores) threads = 1; threads <= cores; threads <<= 1)
+	{
+		BitParallel parallel(threads);
+		count = measure([&] { result = parallel.count(bitSetA); });
+		assign = measure([&] { parallel.assign(bitSet, bitSetA ^ bitSetB); });
+		shift = measure([&] { parallel.shiftLeft(bitSet, POSITION); });
+		copy = measure([&] { slice = parallel.copy(bitSetA, POSITION, SIZE * 32); });
+		cout << threads << " threads: count " << count << " ms, xor " \
+			<< assign << " ms, shift " << shift << " ms, copy " << copy \
+			<< " ms, " << (expected == result) << endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -1,13 +1,48 @@
 ﻿#include "Eterfree/Core/BitSet.hpp"
+#include "Eterfree/Core/BitSetView.hpp"
+#include "Eterfree/Core/FixedBitSet.hpp"
+#include "Eterfree/Core/RankSelect.hpp"
+#include "Eterfree/Core/SequenceBitSet.hpp"
 
+#include <array>
+#include <span>
 #include <concepts>
+#include <cstddef>
 #include <cstdlib>
 #include <climits>
 #include <cstdint>
+#include <new>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <random>
+#include <vector>
 #include <iostream>
 
 USING_ETERFREE_SPACE
 
+// 统计堆内存分配次数
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t _size)
+{
+	++allocations;
+	if (auto pointer = std::malloc(_size))
+		return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	std::free(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t) noexcept
+{
+	std::free(_pointer);
+}
+
 template <std::unsigned_integral _ValueType>
 static void print(const BitSet<_ValueType>& _bitSet)
 {
@@ -39,6 +74,838 @@ static void print(const BitSet<_ValueType>& _bitSet, \
 	print(_bitSet, _positions...);
 }
 
+// 查找与遍历
+static void search()
+{
+	using BitSet = BitSet<std::uint8_t>;
+
+	using std::cout, std::endl;
+
+	BitSet bitSet;
+	for (BitSet::SizeType position : { 3, 9, 10, 30 })
+		bitSet.set(position);
+
+	auto print = [](const char* _name, BitSet::SizeType _position)
+	{
+		cout << _name << ": ";
+		if (_position == BitSet::NPOS) cout << "npos";
+		else cout << _position;
+		cout << endl;
+	};
+
+	cout << "set bits:";
+	for (auto position : bitSet)
+		cout << ' ' << position;
+	cout << endl;
+
+	print("first", bitSet.first());
+	print("last", bitSet.last());
+	print("next 10", bitSet.next(10));
+	print("prev 9", bitSet.prev(9));
+	print("prev 3", bitSet.prev(3));
+	print("find 31", bitSet.find(31));
+	print("rfind 100", bitSet.rfind(100));
+
+	// 分配空闲槽位
+	BitSet::SizeType from = 0, to = 9;
+	bitSet.set(from, to);
+	print("first zero", bitSet.first(false));
+	print("zero from 9", bitSet.find(9, false));
+	print("last zero", bitSet.last(false));
+	print("prev zero 9", bitSet.prev(9, false));
+
+	from = 11;
+	to = 32;
+	bitSet.set(from, to);
+	print("zero after full", bitSet.find(0, false));
+	cout << endl;
+}
+
+// 定长位集合之常量求值，以及小位集合之堆内存分配
+static void fixed()
+{
+	using std::cout, std::endl;
+
+	using Flags = FixedBitSet<std::uint64_t, 100>;
+
+	constexpr Flags::SizeType FROM = 64, TO = 70;
+	constexpr auto flags = Flags(0b1011).set(FROM, TO) << 1;
+	static_assert(flags.count() == 9 and flags[70] and not flags[64]);
+	static_assert(flags.first() == 1 and flags.last() == 70);
+	static_assert(flags.copy(FROM, Flags::BITS) == Flags(0x7E));
+	static_assert((~Flags()).all() and (~Flags()).count() == Flags::BITS);
+	static_assert(Flags().set().flip(99).last(false) == 99);
+	static_assert((Flags().set() >> 99).count() == 1);
+
+	cout << "fixed:";
+	for (auto position : flags)
+		cout << ' ' << position;
+	cout << endl;
+
+	using BitSet = BitSet<std::uint64_t>;
+
+	constexpr auto ROUNDS = 1 << 20;
+
+	auto measure = [](BitSet::SizeType _size)
+	{
+		BitSet bitSetA(_size), bitSetB(_size);
+		bitSetA.set(3);
+		bitSetB.flip(_size * CHAR_BIT * sizeof(BitSet::ValueType) - 1);
+
+		auto base = allocations;
+		BitSet::SizeType counter = 0;
+		for (auto round = 0; round < ROUNDS; ++round)
+		{
+			auto bitSet = (bitSetA | bitSetB) << 1;
+			counter += bitSet.flip().count();
+		}
+		return std::make_pair(allocations - base, counter);
+	};
+
+	for (BitSet::SizeType size : { 1, 2, 3 })
+	{
+		auto [allocation, counter] = measure(size);
+		cout << size * 64 << " bits: " << allocation \
+			<< " allocations, count " << counter / ROUNDS << endl;
+	}
+	cout << endl;
+}
+
+// 外部元素之视图：就地读取与修改，不复制不分配
+static void view()
+{
+	using std::cout, std::endl;
+
+	using View = BitSetView<std::uint64_t>;
+	using SizeType = View::SizeType;
+
+	std::array<std::uint64_t, 3> words = { 0b1011, 0, 1ULL << 63 };
+	const auto& constant = words;
+
+	auto base = allocations;
+	auto reader = BitSetView(std::span(constant));
+	View writer(words.data(), words.size());
+
+	SizeType from = 60, to = 130;
+	writer.set(from, to).flip(3).reset(to + 64);
+	writer ^= BitSetView(std::span(constant));
+
+	BitSet<std::uint64_t> bitSet(2);
+	bitSet.set(1).set(64);
+	BitSetView mask(bitSet);
+	writer |= mask;
+
+	cout << std::boolalpha << "view allocations " \
+		<< allocations - base << ", count " << reader.count() \
+		<< ", equal " << (reader == writer) << endl;
+
+	cout << "view:";
+	for (auto position : reader)
+		cout << ' ' << position;
+	cout << endl;
+
+	cout << "view first zero " << reader.first(false) \
+		<< ", last " << reader.last() << ", find 200 " \
+		<< (reader.find(200) == View::NPOS ? "npos" : "found") << endl;
+
+	writer.reset();
+	cout << "view none " << reader.none() << ", copy size " \
+		<< (mask &= reader).copy().size() << ", source none " \
+		<< bitSet.none() << endl;
+	cout << endl;
+}
+
+// 秩与选择：与逐位统计比较，并验证增量重建
+static bool rank(std::mt19937_64& _random, std::size_t _bits)
+{
+	using BitSet = BitSet<std::uint64_t>;
+	using SizeType = BitSet::SizeType;
+
+	BitSet bitSet((_bits + 63) / 64);
+	std::bernoulli_distribution bit(0.3);
+	for (SizeType position = 0; position < _bits; ++position)
+		if (bit(_random)) bitSet.set(position);
+
+	RankSelect<std::uint64_t> index(bitSet);
+	auto check = [&bitSet, &index]
+	{
+		SizeType counter = 0;
+		for (SizeType position = 0; position < bitSet.size() * 64; ++position)
+		{
+			if (index.rank(position) != counter \
+				or index.rank(position, false) != position - counter)
+				return false;
+
+			if (bitSet[position] and index.select(counter++) != position)
+				return false;
+		}
+		return index.count() == counter \
+			and index.select(counter) == index.NPOS;
+	};
+
+	if (not check()) return false;
+
+	// 修改局部后增量重建
+	std::uniform_int_distribution<SizeType> position(0, _bits - 1);
+	for (auto round = 0; round < 8; ++round)
+	{
+		auto begin = position(_random);
+		auto end = std::min(begin + position(_random) % 1000, _bits);
+		if (round % 2 == 0) bitSet.set(begin, end);
+		else bitSet.flip(begin, end);
+
+		auto single = position(_random);
+		bitSet.flip(single);
+
+		index.update(begin, end);
+		index.update(single);
+		if (not check()) return false;
+	}
+	return true;
+}
+
+template <typename _Left, typename _Right>
+concept Conjunctive = requires(_Left&& _left, _Right&& _right)
+{
+	std::forward<_Left>(_left) & std::forward<_Right>(_right);
+};
+
+// 表达式与逐个运算符之结果一致，操作数长度不同且可为目标
+static bool express()
+{
+	using BitSet = BitSet<std::uint64_t>;
+	using SizeType = BitSet::SizeType;
+
+	BitSet bitSetA(3), bitSetB(5), bitSetC(2);
+	SizeType begin = 10, end = 150;
+	bitSetA.set(begin, end);
+	bitSetB.set(100).set(300).flip(end, end + 100);
+	bitSetC.set(1).set(127);
+
+	// 逐个运算符求值
+	BitSet inverse(bitSetB);
+	inverse.flip();
+	BitSet left(bitSetA), right(bitSetC);
+	left &= inverse;
+	right ^= bitSetA;
+	left |= right;
+
+	BitSet result = (bitSetA & ~bitSetB) | (bitSetC ^ bitSetA);
+	if (result != left or result.size() != left.size() \
+		or ((bitSetA & ~bitSetB) | (bitSetC ^ bitSetA)).count() != left.count())
+		return false;
+
+	// 目标为操作数，结果无需扩容与需要扩容
+	BitSet target(bitSetA);
+	target = (target & bitSetC) ^ bitSetC;
+	inverse = BitSet(bitSetA).flip() &= bitSetC;
+	if (target != inverse or target.size() != 3)
+		return false;
+
+	target = ~target ^ bitSetB;
+	inverse.flip() ^= bitSetB;
+	if (target != inverse or target.size() != 5 \
+		or (~bitSetC).size() != 2 or not (bitSetC & bitSetB).none())
+		return false;
+
+	// 右值位集合不可构造表达式
+	static_assert(not Conjunctive<BitSet, const BitSet&> \
+		and not Conjunctive<const BitSet&, BitSet> \
+		and Conjunctive<const BitSet&, const BitSet&>);
+
+	// auto推导为表达式，引用操作数，eval求值后不再引用
+	auto expression = bitSetA & bitSetC;
+	static_assert(BitExpressionType<decltype(expression)>);
+	auto before = expression.eval();
+	bitSetC.set(begin);
+	auto after = expression.eval();
+	return before.count() == 1 and after.count() == 2 \
+		and after == (bitSetA & bitSetC);
+}
+
+// 逐位对照位移与复制：整字节与非对齐位移，分配复制与缓冲复制
+template <std::unsigned_integral _ValueType>
+static bool shift(std::mt19937_64& _random)
+{
+	using BitSet = BitSet<_ValueType>;
+	using SizeType = typename BitSet::SizeType;
+
+	constexpr SizeType BITS = CHAR_BIT * sizeof(_ValueType);
+	constexpr SizeType EXCESS = 80;
+
+	for (SizeType size : { 1, 3, 17, 67 })
+	{
+		std::vector<_ValueType> data(size);
+		for (auto& element : data)
+			element = static_cast<_ValueType>(_random());
+
+		BitSet source(data.data(), size);
+		auto total = BITS * size;
+
+		for (SizeType round = 0; round < 64; ++round)
+		{
+			// 前若干轮为整字节位移
+			auto position = round < 20 ? CHAR_BIT * round \
+				: _random() % (total + EXCESS);
+
+			BitSet left(source), right(source);
+			left <<= position;
+			right >>= position;
+			for (SizeType index = 0; index < total; ++index)
+			{
+				bool value = index >= position and source[index - position];
+				if (left[index] != value) return false;
+
+				value = index + position < total and source[index + position];
+				if (right[index] != value) return false;
+			}
+
+			// 缓冲复制可越过位集合末尾，分配复制则截断
+			SizeType begin = _random() % total;
+			SizeType end = begin + _random() % (total + EXCESS);
+
+			std::vector<_ValueType> buffer(size + EXCESS / BITS + 2, \
+				static_cast<_ValueType>(~0));
+			auto count = source.copy(begin, end, buffer.data());
+			BitSet slice(buffer.data(), count);
+			for (SizeType index = 0; index < BITS * count; ++index)
+			{
+				auto cursor = begin + index;
+				bool value = cursor < end and cursor < total and source[cursor];
+				if (slice[index] != value) return false;
+			}
+
+			auto copy = source.copy(begin, end);
+			for (SizeType index = 0; index < BITS * copy.size(); ++index)
+				if (copy[index] != slice[index]) return false;
+
+			if (count > 0 and copy.size() != std::min(count, \
+				(std::min(end, total) - begin - 1) / BITS + 1))
+				return false;
+		}
+	}
+	return true;
+}
+
+// 对照直接索引之标记向量：随机标记、前移与累计确认
+static bool sequence(std::mt19937_64& _random)
+{
+	using SequenceBitSet = SequenceBitSet<std::uint32_t>;
+	using SequenceType = SequenceBitSet::SequenceType;
+
+	constexpr SequenceType LIMIT = 1 << 16;
+
+	SequenceBitSet window(100);
+	auto capacity = window.capacity();
+	if (capacity != 128) return false;
+
+	std::vector<bool> marks(LIMIT + 2 * capacity);
+	SequenceType base = 0;
+	auto test = [&](SequenceType _sequence)
+	{
+		return _sequence < base \
+			or (_sequence - base < capacity and marks[_sequence]);
+	};
+
+	while (base < LIMIT)
+	{
+		auto operation = _random() % 16;
+		if (operation == 0)
+		{
+			auto target = base + _random() % (capacity + capacity / 2);
+			window.advance(target);
+			base = std::max(base, target);
+		}
+		else if (operation == 1)
+		{
+			// 确认至首个缺口
+			auto gap = base;
+			while (gap < base + capacity and test(gap)) ++gap;
+			if (window.gap() != gap or window.slide() != gap)
+				return false;
+			base = gap;
+		}
+		else
+		{
+			auto sequence = base + _random() % (2 * capacity);
+			sequence -= std::min<SequenceType>(sequence, 16);
+
+			bool fresh = not test(sequence);
+			if (sequence >= base + capacity)
+				base = sequence - capacity + 1;
+			if (sequence >= base) marks[sequence] = true;
+
+			if (window.mark(sequence) != fresh) return false;
+		}
+
+		if (window.base() != base) return false;
+
+		std::size_t count = 0;
+		for (auto sequence = base - std::min<SequenceType>(base, 8); \
+			sequence < base + capacity + 8; ++sequence)
+		{
+			if (window.test(sequence) != test(sequence)) return false;
+			count += sequence >= base and test(sequence);
+		}
+		if (window.count() != count) return false;
+	}
+	return true;
+}
+
+// 原字节查表统计，作为基准
+static std::size_t count(std::uint64_t _element) noexcept
+{
+	static constexpr auto TABLE = []
+	{
+		std::array<std::uint8_t, 256> table = {};
+		for (std::size_t index = 1; index < table.size(); ++index)
+			table[index] = (index & 1) + table[index >> 1];
+		return table;
+	}();
+
+	std::size_t counter = 0;
+	for (auto index = sizeof _element; index > 0; --index)
+	{
+		counter += TABLE[_element & 0xFF];
+		_element >>= CHAR_BIT;
+	}
+	return counter;
+}
+
+// 原逐元素回调之范围遍历，作为基准
+static void traverse(std::vector<std::uint64_t>& _vector, \
+	std::size_t _begin, std::size_t _end, \
+	std::function<void(std::uint64_t&, std::uint64_t)> _functor)
+{
+	constexpr std::size_t BITS = sizeof(std::uint64_t) * CHAR_BIT;
+
+	auto beginMask = ~0ULL << (_begin % BITS);
+	auto endMask = ~(~0ULL << (_end % BITS));
+
+	auto size = std::min(_vector.size(), (_end - 1) / BITS + 1);
+	_begin /= BITS;
+	_end /= BITS;
+
+	for (auto index = _begin; index < size; ++index)
+	{
+		auto mask = ~0ULL;
+		if (index == _begin) mask &= beginMask;
+
+		if (index == _end) mask &= endMask;
+
+		_functor(_vector[index], mask);
+	}
+}
+
+// 逐位对照范围操作与位移
+static bool verify()
+{
+	using BitSet = BitSet<std::uint8_t>;
+
+	constexpr std::size_t SIZE = 80;
+
+	// 末元素含无效位
+	using FixedBitSet = FixedBitSet<std::uint8_t, SIZE - 3>;
+	constexpr auto BITS = FixedBitSet::BITS;
+
+	std::mt19937 engine(SIZE);
+	BitSet bitSet;
+	FixedBitSet fixedBitSet;
+	std::vector<bool> vector(SIZE);
+	for (auto round = 0; round < 1024; ++round)
+	{
+		std::size_t begin = engine() % SIZE;
+		std::size_t end = engine() % SIZE;
+		auto operation = engine() % 3;
+
+		if (operation == 0)
+		{
+			bitSet.set(begin, end);
+			fixedBitSet.set(begin, end);
+		}
+		else if (operation == 1)
+		{
+			bitSet.reset(begin, end);
+			fixedBitSet.reset(begin, end);
+		}
+		else
+		{
+			bitSet.flip(begin, end);
+			fixedBitSet.flip(begin, end);
+		}
+
+		for (auto position = begin; position < end; ++position)
+			vector[position] = operation == 0 ? true \
+				: operation == 1 ? false : not vector[position];
+
+		std::size_t offset = engine() % SIZE;
+		auto left = fixedBitSet << offset;
+		auto right = fixedBitSet >> offset;
+
+		for (std::size_t position = 0; position < SIZE; ++position)
+		{
+			if (bitSet[position] != vector[position]) return false;
+
+			bool valid = position < BITS;
+			if (fixedBitSet[position] != (valid and vector[position]))
+				return false;
+
+			bool value = valid and position >= offset \
+				and vector[position - offset];
+			if (left[position] != value) return false;
+
+			value = valid and position + offset < BITS \
+				and vector[position + offset];
+			if (right[position] != value) return false;
+		}
+
+		if (fixedBitSet.count() != static_cast<std::size_t>( \
+			std::count(vector.begin(), vector.begin() + BITS, true)))
+			return false;
+	}
+	return true;
+}
+
+// 吞吐量，单位为GB/s
+template <typename _Functor>
+static double measure(std::size_t _size, _Functor _functor)
+{
+	constexpr auto ROUNDS = 64;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (auto round = 0; round < ROUNDS; ++round)
+		_functor();
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return _size * ROUNDS / duration.count();
+}
+
+// 比较逐元素循环与批量核心函数
+static void benchmark()
+{
+	using BitSet = BitSet<std::uint64_t>;
+	using ValueType = BitSet::ValueType;
+
+	using std::cout, std::endl;
+
+	constexpr std::size_t SIZE = 1 << 18;
+	constexpr auto BYTES = sizeof(ValueType) * SIZE;
+
+	std::mt19937_64 engine(SIZE);
+	std::vector<ValueType> left(SIZE), right(SIZE);
+	for (std::size_t index = 0; index < SIZE; ++index)
+	{
+		left[index] = engine();
+		right[index] = engine();
+	}
+
+	BitSet bitSetA(left.data(), SIZE), bitSetB(right.data(), SIZE);
+
+	std::size_t expected = 0, result = 0;
+	auto table = measure(BYTES, [&]
+		{
+			expected = 0;
+			for (auto element : left)
+				expected += count(element);
+		});
+	auto kernel = measure(BYTES, [&]
+		{ result = bitSetA.count(); });
+
+	cout << "count table: " << table << " GB/s, kernel: " \
+		<< kernel << " GB/s, " << std::boolalpha \
+		<< (expected == result) << endl;
+
+	auto loop = measure(BYTES, [&]
+		{
+			for (std::size_t index = 0; index < SIZE; ++index)
+				left[index] ^= right[index];
+		});
+	kernel = measure(BYTES, [&] { bitSetA ^= bitSetB; });
+
+	// 偶数轮异或还原
+	BitSet bitSet(left.data(), SIZE);
+	cout << "xor loop: " << loop << " GB/s, kernel: " \
+		<< kernel << " GB/s, " << (bitSet == bitSetA) << endl;
+
+	loop = measure(BYTES, [&]
+		{
+			for (auto& element : left)
+				element = ~element;
+		});
+	kernel = measure(BYTES, [&] { bitSetA.flip(); });
+
+	bitSet = BitSet(left.data(), SIZE);
+	cout << "flip loop: " << loop << " GB/s, kernel: " \
+		<< kernel << " GB/s, " << (bitSet == bitSetA) << endl;
+
+	// 全零时须扫描所有元素
+	bitSet = BitSet(SIZE);
+	kernel = measure(BYTES, [&] { result = bitSet.none(); });
+	cout << "none kernel: " << kernel << " GB/s, " \
+		<< (result != 0) << endl;
+
+	cout << "range verify: " << verify() << endl;
+
+	// 首尾非对齐之范围
+	BitSet::SizeType from = 7, to = BYTES * CHAR_BIT - 5;
+	using Functor = std::function<void(ValueType&, ValueType)>;
+	Functor functors[] = {
+		[](ValueType& _element, ValueType _mask) { _element |= _mask; },
+		[](ValueType& _element, ValueType _mask) { _element &= ~_mask; },
+		[](ValueType& _element, ValueType _mask) { _element ^= _mask; }
+	};
+	const char* names[] = { "set", "reset", "flip" };
+
+	for (std::size_t index = 0; index < std::size(functors); ++index)
+	{
+		loop = measure(BYTES, [&]
+			{ traverse(left, from, to, functors[index]); });
+		kernel = measure(BYTES, [&]
+			{
+				if (index == 0) bitSetA.set(from, to);
+				else if (index == 1) bitSetA.reset(from, to);
+				else bitSetA.flip(from, to);
+			});
+
+		bitSet = BitSet(left.data(), SIZE);
+		cout << names[index] << " range functor: " << loop \
+			<< " GB/s, traverse: " << kernel << " GB/s, " \
+			<< (bitSet == bitSetA) << endl;
+	}
+
+	cout << "shift verify: " << (shift<std::uint8_t>(engine) \
+		and shift<std::uint16_t>(engine) and shift<std::uint32_t>(engine) \
+		and shift<std::uint64_t>(engine)) << endl;
+
+	// 原逐字位移，作为基准
+	auto shiftLeft = [&left](std::size_t _position)
+	{
+		auto offset = _position / 64, shift = _position % 64;
+		for (auto index = SIZE; index > 0; --index)
+		{
+			auto cursor = index - 1;
+			auto high = cursor >= offset ? left[cursor - offset] : 0;
+			auto low = cursor > offset ? left[cursor - offset - 1] : 0;
+			left[cursor] = shift > 0 ? (high << shift) | (low >> (64 - shift)) : high;
+		}
+	};
+	auto shiftRight = [&left](std::size_t _position)
+	{
+		auto offset = _position / 64, shift = _position % 64;
+		for (std::size_t index = 0; index < SIZE; ++index)
+		{
+			auto cursor = index + offset;
+			auto low = cursor < SIZE ? left[cursor] : 0;
+			auto high = cursor + 1 < SIZE ? left[cursor + 1] : 0;
+			left[index] = shift > 0 ? (low >> shift) | (high << (64 - shift)) : low;
+		}
+	};
+
+	// 整字与非对齐位移
+	for (std::size_t position : { 64, 13 })
+	{
+		bitSetA = BitSet(left.data(), SIZE);
+		loop = measure(BYTES, [&] { shiftLeft(position); });
+		kernel = measure(BYTES, [&] { bitSetA <<= position; });
+
+		bitSet = BitSet(left.data(), SIZE);
+		cout << "shift left " << position << " loop: " << loop \
+			<< " GB/s, kernel: " << kernel << " GB/s, " \
+			<< (bitSet == bitSetA) << endl;
+
+		loop = measure(BYTES, [&] { shiftRight(position); });
+		kernel = measure(BYTES, [&] { bitSetA >>= position; });
+
+		bitSet = BitSet(left.data(), SIZE);
+		cout << "shift right " << position << " loop: " << loop \
+			<< " GB/s, kernel: " << kernel << " GB/s, " \
+			<< (bitSet == bitSetA) << endl;
+	}
+
+	// 分配复制与缓冲复制
+	for (std::size_t index = 0; index < SIZE; ++index)
+		left[index] = engine();
+	bitSetA = BitSet(left.data(), SIZE);
+
+	std::vector<ValueType> buffer(SIZE);
+	BitSet slice;
+	auto allocate = measure(BYTES, [&]
+		{ slice = bitSetA.copy(from, to); });
+	kernel = measure(BYTES, [&]
+		{ bitSetA.copy(from, to, buffer.data()); });
+
+	bitSet = BitSet(buffer.data(), slice.size());
+	cout << "copy allocate: " << allocate << " GB/s, buffer: " \
+		<< kernel << " GB/s, " << (bitSet == slice) << endl;
+
+	cout << "sequence verify: " << sequence(engine) << endl;
+
+	// 乱序且含重放之序列号：前移时整体右移位集合与环形窗口
+	constexpr std::size_t WINDOW = 4096;
+
+	std::vector<std::uint64_t> sequences(SIZE);
+	for (std::size_t index = 0; index < SIZE; ++index)
+		sequences[index] = index + engine() % 256;
+
+	BitSet shifted(WINDOW / 64);
+	SequenceBitSet<ValueType> ring(WINDOW);
+
+	auto shifting = measure(SIZE, [&]
+		{
+			auto& window = shifted.reset();
+			std::uint64_t base = 0;
+
+			expected = 0;
+			for (auto sequence : sequences)
+			{
+				if (sequence < base) continue;
+
+				if (sequence - base >= WINDOW)
+				{
+					auto offset = sequence - WINDOW + 1 - base;
+					window >>= offset;
+					base += offset;
+				}
+
+				auto position = sequence - base;
+				if (window[position]) continue;
+
+				window.set(position);
+				++expected;
+			}
+		});
+	kernel = measure(SIZE, [&]
+		{
+			ring.reset(0);
+
+			result = 0;
+			for (auto sequence : sequences)
+				result += ring.mark(sequence);
+		});
+
+	cout << "sequence shift: " << shifting * 1e3 << " M/s, ring: " \
+		<< kernel * 1e3 << " M/s, " << (expected == result) << endl;
+
+	// 稀疏位集合：逐位探测与迭代器
+	bitSet.reset();
+	for (std::size_t index = 0; index < SIZE; index += 61)
+		bitSet.set(index * 67 % (BYTES * CHAR_BIT));
+
+	auto probe = measure(BYTES, [&]
+		{
+			expected = 0;
+			for (std::size_t position = 0; \
+				position < BYTES * CHAR_BIT; ++position)
+				if (bitSet[position]) expected += position;
+		});
+	kernel = measure(BYTES, [&]
+		{
+			result = 0;
+			for (auto position : bitSet)
+				result += position;
+		});
+
+	cout << "iterate probe: " << probe << " GB/s, iterator: " \
+		<< kernel << " GB/s, " << (expected == result) << endl;
+
+	// 多路组合：逐个运算符生成临时位集合与融合求值
+	std::vector<ValueType> third(SIZE), fourth(SIZE);
+	for (std::size_t index = 0; index < SIZE; ++index)
+	{
+		third[index] = engine();
+		fourth[index] = engine();
+	}
+
+	BitSet bitSetC(third.data(), SIZE), bitSetD(fourth.data(), SIZE);
+
+	auto eager = measure(BYTES * 4, [&]
+		{
+			BitSet left(bitSetA), right(bitSetC);
+			left &= bitSetB;
+			right ^= bitSetD;
+			bitSet = left |= right;
+		});
+	kernel = measure(BYTES * 4, [&]
+		{ bitSet = (bitSetA & bitSetB) | (bitSetC ^ bitSetD); });
+
+	cout << "expression verify: " << express() << endl;
+	cout << "expression eager: " << eager << " GB/s, fused: " \
+		<< kernel << " GB/s" << endl;
+
+	eager = measure(BYTES * 4, [&]
+		{
+			BitSet left(bitSetA), right(bitSetC);
+			left &= bitSetB;
+			right ^= bitSetD;
+			expected = (left |= right).count();
+		});
+	kernel = measure(BYTES * 4, [&]
+		{ result = ((bitSetA & bitSetB) | (bitSetC ^ bitSetD)).count(); });
+
+	cout << "expression count eager: " << eager << " GB/s, fused: " \
+		<< kernel << " GB/s, " << (expected == result) << endl;
+
+	cout << "rank verify: " << (rank(engine, 100000) \
+		and rank(engine, 300007)) << endl;
+
+	// 随机秩查询：逐元素统计前缀与索引
+	constexpr std::size_t QUERIES = 1024;
+
+	std::vector<std::size_t> positions(QUERIES);
+	for (auto& position : positions)
+		position = engine() % (BYTES * CHAR_BIT);
+
+	RankSelect<ValueType> index;
+	auto build = measure(BYTES, [&] { index.build(bitSetA); });
+
+	auto scan = measure(QUERIES, [&]
+		{
+			expected = 0;
+			for (auto position : positions)
+			{
+				auto size = position / 64;
+				expected += countBit(bitSetA.data(), sizeof(ValueType) * size) \
+					+ std::popcount(left[size] & ((1ULL << position % 64) - 1));
+			}
+		});
+	kernel = measure(QUERIES, [&]
+		{
+			result = 0;
+			for (auto position : positions)
+				result += index.rank(position);
+		});
+
+	cout << "rank build: " << build << " GB/s, overhead " \
+		<< index.usage() * 100.0 / BYTES << "%" << endl;
+	cout << "rank scan: " << scan * 1e3 << " M/s, index: " \
+		<< kernel * 1e3 << " M/s, " << (expected == result) << endl;
+
+	// 随机选择查询：有效位迭代器与索引
+	for (auto& position : positions)
+		position = engine() % index.count();
+
+	auto iterate = measure(QUERIES / 64, [&]
+		{
+			expected = 0;
+			for (std::size_t query = 0; query < QUERIES / 64; ++query)
+			{
+				auto iterator = bitSetA.begin();
+				std::advance(iterator, positions[query]);
+				expected += *iterator;
+			}
+		});
+	kernel = measure(QUERIES / 64, [&]
+		{
+			result = 0;
+			for (std::size_t query = 0; query < QUERIES / 64; ++query)
+				result += index.select(positions[query]);
+		});
+
+	cout << "select iterate: " << iterate * 1e3 << " M/s, index: " \
+		<< kernel * 1e3 << " M/s, " << (expected == result) << endl;
+}
+
 int main()
 {
 	using BitSet = BitSet<std::uint64_t>;
@@ -238,5 +1105,10 @@ int main()
 	print(bitSet2);
 	print(bitSet2, LOW, MIDDLE, HIGH);
 	cout << endl;
+
+	search();
+	fixed();
+	view();
+	benchmark();
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,201 @@
+﻿#include "Eterfree/Core/BloomFilter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_set>
+
+USING_ETERFREE_SPACE
+
+using KeyType = std::uint64_t;
+using SizeType = std::size_t;
+
+// 预期元素数量与误判率
+constexpr SizeType COUNT = 1 << 20;
+constexpr double RATE = 0.01;
+
+// 已插入之键无漏判，单个与批量接口一致
+template <typename _Filter>
+static bool verify(const std::vector<KeyType>& _keys, \
+	const std::vector<KeyType>& _absent)
+{
+	auto filter = _Filter::optimal(_keys.size(), RATE);
+	for (SizeType index = 0; index < _keys.size() / 2; ++index)
+		filter.insert(_keys[index]);
+	filter.insert(std::span(_keys).subspan(_keys.size() / 2));
+
+	for (auto key : _keys)
+		if (not filter.exist(key)) return false;
+
+	auto results = std::make_unique<bool[]>(_absent.size());
+	auto counter = filter.exist(_absent, results.get());
+
+	SizeType positives = 0;
+	for (SizeType index = 0; index < _absent.size(); ++index)
+	{
+		if (results[index] != filter.exist(_absent[index])) return false;
+		positives += results[index];
+	}
+
+	// 误判率不超出预期之两倍
+	if (counter != positives or positives > 2 * RATE * _absent.size())
+		return false;
+
+	std::string message = "不赌天意，不猜人心。";
+	filter.insert(message.data(), message.size());
+	if (not filter.exist(message.data(), message.size()))
+		return false;
+
+	// 复制之过滤器位于新内存，仍无漏判
+	auto copy = std::make_unique<_Filter>(filter);
+	_Filter assignment = _Filter::optimal(1, RATE);
+	assignment = *copy;
+	for (auto key : _keys)
+		if (not copy->exist(key) or not assignment.exist(key))
+			return false;
+	return true;
+}
+
+// 误判率超出(0, 1)则取边界，规模有限且无漏判
+template <typename _Filter>
+static bool clamp()
+{
+	for (auto rate : { 0.0, -1.0, 1.0, 2.0, std::nan("") })
+	{
+		auto filter = _Filter::optimal(COUNT, rate);
+		if (filter.hashes() < 1 or filter.usage() <= 0 \
+			or filter.usage() > COUNT * 64)
+			return false;
+
+		filter.insert(COUNT);
+		if (not filter.exist(COUNT)) return false;
+	}
+	return true;
+}
+
+// 删除一半之键，余下之键无漏判
+static bool remove(const std::vector<KeyType>& _keys, \
+	const std::vector<KeyType>& _absent)
+{
+	auto filter = CountingBloomFilter::optimal(_keys.size(), RATE);
+	filter.insert(_keys);
+
+	auto half = _keys.size() / 2;
+	for (SizeType index = 0; index < half; ++index)
+		if (not filter.remove(_keys[index])) return false;
+
+	for (SizeType index = half; index < _keys.size(); ++index)
+		if (not filter.exist(_keys[index])) return false;
+
+	SizeType positives = 0;
+	for (SizeType index = 0; index < half; ++index)
+		positives += filter.exist(_keys[index]);
+	for (auto key : _absent)
+		positives += filter.exist(key);
+	if (positives > 2 * RATE * (half + _absent.size()))
+		return false;
+
+	filter.clear();
+	return not filter.exist(_keys.back());
+}
+
+// 单次操作耗时，单位为纳秒
+template <typename _Functor>
+static double measure(SizeType _size, _Functor _functor)
+{
+	auto begin = std::chrono::steady_clock::now();
+	_functor();
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return duration.count() / _size;
+}
+
+// 逐个与批量插入、查询不存在之键，统计误判率
+template <typename _Filter>
+static void benchmark(const char* _name, \
+	const std::vector<KeyType>& _keys, const std::vector<KeyType>& _absent)
+{
+	using std::cout, std::endl;
+
+	auto filter = _Filter::optimal(_keys.size(), RATE);
+	auto single = measure(_keys.size(), [&]
+		{
+			for (auto key : _keys)
+				filter.insert(key);
+		});
+
+	filter.clear();
+	auto batch = measure(_keys.size(), [&] { filter.insert(_keys); });
+
+	SizeType positives = 0;
+	auto query = measure(_absent.size(), [&]
+		{
+			for (auto key : _absent)
+				positives += filter.exist(key);
+		});
+
+	auto results = std::make_unique<bool[]>(_absent.size());
+	auto batchQuery = measure(_absent.size(), [&]
+		{ filter.exist(_absent, results.get()); });
+
+	cout << _name << ": insert " << single << " ns, batch " << batch \
+		<< " ns; query " << query << " ns, batch " << batchQuery \
+		<< " ns; false positive " << positives * 100.0 / _absent.size() \
+		<< "%, " << filter.usage() / 1024 << " KiB" << endl;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	std::mt19937_64 engine(COUNT);
+
+	// 已插入之键与不存在之键互不相同
+	std::unordered_set<KeyType> set;
+	std::vector<KeyType> keys, absent;
+	while (keys.size() < COUNT)
+		if (auto key = engine(); set.insert(key).second)
+			keys.push_back(key);
+	while (absent.size() < COUNT)
+		if (auto key = engine(); set.insert(key).second)
+			absent.push_back(key);
+
+	cout << std::boolalpha << "verify: " \
+		<< (verify<BloomFilter>(keys, absent) \
+			and verify<BlockedBloomFilter>(keys, absent) \
+			and verify<CountingBloomFilter>(keys, absent)) << endl;
+	cout << "remove verify: " << remove(keys, absent) << endl;
+	cout << "rate clamp: " << (clamp<BloomFilter>() \
+		and clamp<BlockedBloomFilter>() and clamp<CountingBloomFilter>()) << endl;
+
+	// 基准：散列集合
+	std::unordered_set<KeyType> reference;
+	auto insert = measure(COUNT, [&]
+		{
+			for (auto key : keys)
+				reference.insert(key);
+		});
+
+	SizeType positives = 0;
+	auto query = measure(COUNT, [&]
+		{
+			for (auto key : absent)
+				positives += reference.contains(key);
+		});
+
+	cout << "hash set: insert " << insert << " ns; query " << query \
+		<< " ns; false positive " << positives << endl;
+
+	benchmark<BloomFilter>("bloom", keys, absent);
+	benchmark<BlockedBloomFilter>("blocked bloom", keys, absent);
+	benchmark<CountingBloomFilter>("counting bloom", keys, absent);
+	return EXIT_SUCCESS;
+}
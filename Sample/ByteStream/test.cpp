@@ -3,7 +3,9 @@
 #include <cstdlib>
 #include <cstdint>
 #include <cstring>
+#include <string>
 #include <random>
+#include <chrono>
 #include <iostream>
 
 USING_ETERFREE_SPACE
@@ -113,6 +115,306 @@ static void take(InputByteStream& _input, \
 	}
 }
 
+// 控制通道之数据包优先于批量通道
+static void schedule(ByteStream::FlagType _flag)
+{
+	using std::cout, std::endl;
+
+	OutputByteStream output;
+	output.replaceFlag(_flag);
+
+	InputByteStream input;
+	input.replaceFlag(_flag);
+
+	for (auto sentence : PARAGRAPH)
+		output.put(sentence);
+	output.put(SENTENCE, std::strlen(SENTENCE), \
+		OutputByteStream::LANE_TYPE_CONTROL);
+
+	move(output, input);
+
+	ByteStream::QueueType queue;
+	take(input, queue);
+
+	cout << "\nschedule\n";
+	for (const auto& packet : queue)
+		cout << packet << endl;
+}
+
+// 字节数越过水位时通知
+static void watermark(ByteStream::FlagType _flag)
+{
+	using std::cout, std::boolalpha, std::endl;
+
+	constexpr ByteStream::SizeType HIGH = 64;
+	constexpr ByteStream::SizeType LOW = 32;
+
+	OutputByteStream output;
+	output.replaceFlag(_flag);
+	output.watermark(HIGH, LOW);
+	output.notify([](bool _congested)
+		{ cout << "congested " << boolalpha << _congested << endl; });
+
+	InputByteStream input;
+	input.replaceFlag(_flag);
+
+	cout << "\nwatermark\n";
+	for (auto sentence : PARAGRAPH)
+		cout << boolalpha << output.put(sentence) \
+			<< ' ' << output.usage() << endl;
+
+	move(output, input);
+	cout << output.usage() << ' ' << input.usage() << endl;
+
+	// 解析数据包只计净字节数，越过高水位后降至低水位之下解除拥塞
+	constexpr ByteStream::SizeType SIZE = 60;
+	constexpr ByteStream::SizeType PACKETS = 2;
+
+	InputByteStream receiver;
+	receiver.replaceFlag(_flag);
+	receiver.watermark(100, 10);
+	receiver.notify([](bool _congested)
+		{ cout << "input congested " << boolalpha << _congested << endl; });
+
+	std::string packet(SIZE, 'x');
+	for (ByteStream::SizeType index = 0; index < PACKETS; ++index)
+	{
+		output.put(packet.data(), packet.size());
+		move(output, receiver);
+		cout << "input " << receiver.usage() \
+			<< ' ' << boolalpha << receiver.idle() << endl;
+	}
+
+	ByteStream::QueueType queue;
+	receiver.take(queue);
+	cout << "input " << receiver.usage() \
+		<< ' ' << boolalpha << receiver.idle() << endl;
+}
+
+// 未复用信道之队列已满，数据包留于缓冲，暂停接收
+static void backpressure(ByteStream::FlagType _flag)
+{
+	using std::cout, std::boolalpha, std::endl;
+
+	OutputByteStream output;
+	output.replaceFlag(_flag);
+
+	InputByteStream input(0, 1);
+	input.replaceFlag(_flag);
+
+	for (auto sentence : PARAGRAPH)
+		output.put(sentence);
+	move(output, input);
+
+	cout << "\nbackpressure\n" << boolalpha << input.idle() << endl;
+
+	ByteStream::Buffer packet;
+	while (input.take(packet))
+	{
+		input.flush();
+		cout << input.idle() << ' ' << packet << endl;
+	}
+}
+
+// 多个信道共享连接，流量配额不足之信道不阻塞其他信道
+static void multiplex(ByteStream::FlagType _flag)
+{
+	using std::cout, std::endl;
+
+	constexpr ByteStream::ChannelType CHANNELS[] = { 1, 2 };
+
+	ByteStream::setFlag(_flag, ByteStream::FLAG_TYPE_CHANNEL);
+
+	OutputByteStream output;
+	output.replaceFlag(_flag);
+	output.grant(CHANNELS[1], 0);
+
+	InputByteStream input;
+	input.replaceFlag(_flag);
+
+	for (auto sentence : PARAGRAPH)
+		for (auto channel : CHANNELS)
+			output.put(channel, sentence, std::strlen(sentence));
+
+	// 配额不足之数据包滞留输出字节流
+	auto transfer = [&output, &input]
+	{
+		ByteStream::SizeType size = ByteStream::MAX_SIZE;
+		auto data = output.data(size);
+		input.put(data, size);
+		output.take(size);
+	};
+
+	auto print = [&input, &CHANNELS]
+	{
+		ByteStream::Buffer packet;
+		for (auto channel : CHANNELS)
+			while (input.take(channel, packet))
+				cout << channel << ' ' << packet << endl;
+	};
+
+	cout << "\nmultiplex\n";
+	transfer();
+	print();
+
+	output.grant(CHANNELS[1], ByteStream::MAX_SIZE);
+	transfer();
+	print();
+
+	// 清空数据不影响流量配额
+	output.grant(CHANNELS[0], 0);
+	output.put(CHANNELS[0], SENTENCE, std::strlen(SENTENCE));
+	output.clear();
+	cout << "clear " << output.empty() << " credit " \
+		<< output.credit(CHANNELS[0]) << endl;
+	output.revoke(CHANNELS[0]);
+
+	// 接收端队列已满之信道数据包滞留，不阻塞其他信道
+	InputByteStream receiver(0, 1);
+	receiver.replaceFlag(_flag);
+
+	for (auto sentence : PARAGRAPH)
+		output.put(CHANNELS[0], sentence, std::strlen(sentence));
+	output.put(CHANNELS[1], SENTENCE, std::strlen(SENTENCE));
+	move(output, receiver);
+
+	ByteStream::Buffer packet;
+	if (receiver.take(CHANNELS[1], packet))
+		cout << CHANNELS[1] << ' ' << packet << endl;
+
+	while (receiver.take(CHANNELS[0], packet))
+	{
+		cout << CHANNELS[0] << ' ' << packet << endl;
+		receiver.flush();
+	}
+	cout << std::boolalpha << "empty " << receiver.empty() \
+		<< " usage " << receiver.usage() << endl;
+
+	// 信道无数据包，调用者之队列保持不变
+	ByteStream::QueueType queue{ SENTENCE };
+	for (auto channel : CHANNELS)
+		cout << "take " << channel << ' ' << receiver.take(channel, queue) \
+			<< ' ' << queue.size() << endl;
+	cout << "take 7 " << receiver.take(7, queue) \
+		<< ' ' << queue.size() << endl;
+}
+
+// 负载对齐：接收缓冲内之负载起始于对齐边界
+static void align(ByteStream::FlagType _flag)
+{
+	using std::cout, std::endl;
+
+	using SizeType = ByteStream::SizeType;
+
+	cout << "\nalign\n";
+	for (SizeType alignment : { 0, 8, 16, 64 })
+	{
+		OutputByteStream output;
+		output.replaceFlag(_flag);
+		output.alignment(alignment);
+
+		InputByteStream input;
+		input.replaceFlag(_flag);
+		input.alignment(alignment);
+
+		for (auto sentence : PARAGRAPH)
+			output.put(sentence);
+		move(output, input);
+
+		SizeType count = 0;
+		ByteStream::Buffer packet;
+		for (auto sentence : PARAGRAPH)
+			if (input.take(packet) and packet == sentence)
+				++count;
+
+		// 就地访问之负载起始于对齐边界
+		SizeType aligned = 0;
+		auto visitor = [alignment, &aligned](ByteStream::ChannelType, \
+			const char* _data, SizeType)
+		{
+			auto address = reinterpret_cast<std::uintptr_t>(_data);
+			if (alignment <= 1 or address % alignment == 0)
+				++aligned;
+			return true;
+		};
+
+		for (auto sentence : PARAGRAPH)
+			output.put(sentence);
+		while (not output.empty())
+		{
+			SizeType size = ByteStream::MAX_SIZE;
+			auto data = output.data(size);
+			input.put(data, size, visitor);
+			output.take(size);
+		}
+
+		cout << alignment << ": " << count << '/' \
+			<< std::size(PARAGRAPH) << ' ' << aligned << '/' \
+			<< std::size(PARAGRAPH) << ' ' << std::boolalpha \
+			<< (output.usage() == 0 and input.usage() == 0) << endl;
+	}
+}
+
+// 数值负载之接收吞吐量，单位GB/s
+static double receive(ByteStream::FlagType _flag, \
+	ByteStream::SizeType _alignment, bool _visit = false)
+{
+	using SizeType = ByteStream::SizeType;
+
+	constexpr SizeType NUMBER = 509;
+	constexpr SizeType PACKETS = 64;
+	constexpr SizeType ROUNDS = 512;
+
+	// 负载长度非八之倍数，无填充则后续负载错位
+	ByteStream::Buffer packet(NUMBER * sizeof(double) + 3, '\0');
+	for (SizeType index = 0; index < NUMBER; ++index)
+	{
+		auto value = index * 0.5;
+		std::memcpy(packet.data() + index * sizeof value, \
+			&value, sizeof value);
+	}
+
+	OutputByteStream output;
+	output.replaceFlag(_flag);
+	output.alignment(_alignment);
+
+	SizeType size = ByteStream::MAX_SIZE;
+	for (SizeType index = 0; index < PACKETS; ++index)
+		output.put(packet);
+	auto data = output.data(size);
+	ByteStream::Buffer stream(data, size);
+
+	InputByteStream input;
+	input.replaceFlag(_flag);
+	input.alignment(_alignment);
+
+	double sum = 0;
+	InputByteStream::Visitor visitor;
+	if (_visit)
+		visitor = [&sum](ByteStream::ChannelType, \
+			const char* _data, SizeType)
+		{
+			sum += reinterpret_cast<const double*>(_data)[NUMBER - 1];
+			return true;
+		};
+
+	auto begin = std::chrono::steady_clock::now();
+	for (SizeType round = 0; round < ROUNDS; ++round)
+	{
+		input.put(stream, visitor);
+		while (input.take(packet))
+			sum += reinterpret_cast<const double*>(packet.data())[NUMBER - 1];
+	}
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+
+	volatile auto result = sum;
+	(void)result;
+	return static_cast<double>(packet.size() * PACKETS * ROUNDS) \
+		/ duration.count();
+}
+
 int main()
 {
 	using SizeType = ByteStream::SizeType;
@@ -155,5 +457,16 @@ int main()
 	cout << "\ninput\n";
 	for (const auto& packet : queue)
 		cout << packet << endl;
+
+	schedule(flag);
+	watermark(flag);
+	backpressure(flag);
+	multiplex(flag);
+
+	align(flag);
+	cout << "receive: unaligned " << receive(flag, 0) \
+		<< " GB/s, aligned " << receive(flag, 64) \
+		<< " GB/s, in place " << receive(flag, 64, true) \
+		<< " GB/s" << endl;
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,290 @@
+﻿#include "Eterfree/Core/ConnectionTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+USING_ETERFREE_SPACE
+
+using KeyType = ConnectionTable::KeyType;
+
+static const char* SENTENCE = "不赌天意，不猜人心。";
+
+// 统计堆内存占用
+static std::atomic<std::size_t> allocation = 0;
+
+// 头部记录原始地址与字节数
+static constexpr auto HEADER = sizeof(void*) + sizeof(std::size_t);
+
+static void* allocate(std::size_t _size, std::size_t _alignment)
+{
+	auto pointer = static_cast<char*>(std::malloc(HEADER + _alignment + _size));
+	if (pointer == nullptr) throw std::bad_alloc();
+
+	auto address = reinterpret_cast<std::uintptr_t>(pointer) + HEADER;
+	address = (address + _alignment - 1) / _alignment * _alignment;
+
+	auto result = reinterpret_cast<char*>(address);
+	std::memcpy(result - HEADER, &pointer, sizeof pointer);
+	std::memcpy(result - sizeof _size, &_size, sizeof _size);
+
+	allocation.fetch_add(_size, std::memory_order::relaxed);
+	return result;
+}
+
+static void deallocate(void* _pointer) noexcept
+{
+	if (_pointer == nullptr) return;
+
+	auto result = static_cast<char*>(_pointer);
+
+	char* pointer = nullptr;
+	std::memcpy(&pointer, result - HEADER, sizeof pointer);
+
+	std::size_t size = 0;
+	std::memcpy(&size, result - sizeof size, sizeof size);
+
+	allocation.fetch_sub(size, std::memory_order::relaxed);
+	std::free(pointer);
+}
+
+void* operator new(std::size_t _size)
+{
+	return allocate(_size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t _size, std::align_val_t _alignment)
+{
+	return allocate(_size, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::align_val_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t, \
+	std::align_val_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+// 模拟套接字：将输出字节流数据转移至输入字节流
+static void move(KeyType, Connection& _connection)
+{
+	auto& output = _connection.output();
+	auto& input = _connection.input();
+
+	ByteStream::SizeType size = ByteStream::MAX_SIZE;
+	auto data = output.data(size);
+
+	decltype(size) offset = 0;
+	while (offset < size)
+		if (not input.put(data, size, offset))
+			break;
+
+	output.take(offset);
+}
+
+// 消费数据包，并回复相同内容
+static void echo(KeyType, Connection& _connection)
+{
+	ByteStream::Buffer packet;
+	while (_connection.input().take(packet))
+		_connection.output().put(packet);
+}
+
+static double benchmark(ConnectionTable::SizeType _threads)
+{
+	using SizeType = ConnectionTable::SizeType;
+
+	constexpr SizeType CONNECTIONS = 4096;
+	constexpr SizeType ROUNDS = 64;
+
+	ConnectionTable table(_threads);
+	for (KeyType key = 0; key < CONNECTIONS; ++key)
+	{
+		table.insert(key);
+		table.find(key, [](KeyType, Connection& _connection)
+			{ _connection.output().put(SENTENCE); });
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (SizeType index = 0; index < _threads; ++index)
+		threads.emplace_back([&table, index]
+			{
+				for (SizeType round = 0; round < ROUNDS; ++round)
+					table.process(index, echo, move);
+			});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	std::chrono::duration<double> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return CONNECTIONS * ROUNDS / duration.count();
+}
+
+// 消费所有数据包
+static void drain(KeyType, Connection& _connection)
+{
+	ByteStream::Buffer packet;
+	while (_connection.input().take(packet));
+}
+
+// 统计空闲连接之平均内存占用
+static void idle()
+{
+	using std::cout, std::endl;
+
+	using SizeType = ConnectionTable::SizeType;
+
+	constexpr SizeType CONNECTIONS = 16384;
+	constexpr SizeType BURST = 16384;
+	constexpr SizeType ROUNDS = 2;
+
+	auto base = allocation.load();
+	auto print = [base](const char* _state)
+	{
+		auto size = allocation.load() - base;
+		cout << _state << ": " << size / CONNECTIONS \
+			<< " bytes/connection" << endl;
+	};
+
+	ConnectionTable table(1);
+	for (KeyType key = 0; key < CONNECTIONS; ++key)
+		table.insert(key);
+	print("created");
+
+	ByteStream::Buffer burst(BURST, '\0');
+	for (KeyType key = 0; key < CONNECTIONS; ++key)
+		table.find(key, [&burst](KeyType, Connection& _connection)
+			{ _connection.output().put(burst); });
+
+	while (table.process(0, drain, move) > 0);
+	print("after burst");
+
+	table.rounds(ROUNDS);
+	for (SizeType round = 0; round < ROUNDS; ++round)
+		table.process(0, drain, move);
+	print("after trim");
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	auto cores = std::thread::hardware_concurrency();
+	if (cores <= 0) cores = 1;
+
+	for (decltype(cores) threads = 1; threads <= cores; threads <<= 1)
+		cout << threads << " threads: " \
+			<< static_cast<std::uint64_t>(benchmark(threads)) \
+			<< " packets/s" << endl;
+
+	constexpr ConnectionTable::SizeType BUDGET = 4096;
+
+	ConnectionTable table(1, BUDGET);
+	for (KeyType key = 0; key < 64; ++key)
+		table.insert(key);
+
+	table.process(0, nullptr, [](KeyType, Connection&) {});
+	cout << "\nbudget " << table.budget() \
+		<< " usage " << table.usage() << endl;
+
+	table.find(0, [](KeyType, Connection& _connection)
+		{
+			for (auto index = 0; index < 256; ++index)
+				_connection.output().put(SENTENCE);
+		});
+	table.process(0, nullptr, nullptr);
+	cout << "budget " << table.budget() \
+		<< " usage " << table.usage() << endl;
+
+	auto put = [&table](KeyType _key)
+	{
+		bool result = false;
+		table.find(_key, [&result](KeyType, Connection& _connection)
+			{
+				auto& output = _connection.output();
+				result = output.put(SENTENCE) and output.put(SENTENCE);
+			});
+		return result;
+	};
+
+	// 限流不限制控制通道，解除后恢复各通道容量
+	auto lanes = [&table](KeyType _key)
+	{
+		using LANE_TYPE = OutputByteStream::LANE_TYPE;
+
+		table.find(_key, [](KeyType, Connection& _connection)
+			{
+				auto& output = _connection.output();
+				cout << "capacity control " \
+					<< output.capacity(LANE_TYPE::LANE_TYPE_CONTROL) \
+					<< " bulk " << output.capacity(LANE_TYPE::LANE_TYPE_BULK) \
+					<< " invalid " << output.capacity(LANE_TYPE::LANE_TYPE_SIZE) << endl;
+
+				bool result = true;
+				for (auto index = 0; index < 2; ++index)
+					result = output.put(SENTENCE, std::strlen(SENTENCE), \
+						LANE_TYPE::LANE_TYPE_CONTROL) and result;
+				cout << std::boolalpha << "put control " << result << endl;
+
+				// 限流时输入队列容量为一，接收一个数据包即暂停接收
+				OutputByteStream sender;
+				sender.put(SENTENCE);
+				ByteStream::SizeType size = ByteStream::MAX_SIZE;
+				auto data = sender.data(size);
+
+				auto& input = _connection.input();
+				input.put(data, size);
+				cout << "input idle " << input.idle() << endl;
+				input.clear();
+			});
+	};
+
+	cout << std::boolalpha << "put " << put(1) << endl;
+	lanes(1);
+
+	// 空闲连接释放缓冲，空闲块归还上游后占用回落
+	while (table.process(0, drain, move) > 0);
+	table.rounds(1);
+	table.process(0, drain, move);
+	table.process(0, drain, move);
+	cout << "\nbudget " << table.budget() \
+		<< " usage " << table.usage() << endl;
+	cout << std::boolalpha << "put " << put(1) << endl;
+	lanes(1);
+
+	// 删除连接立即扣除其占用
+	table.find(0, [](KeyType, Connection& _connection)
+		{ _connection.output().put(SENTENCE); });
+	table.process(0, nullptr, nullptr);
+	auto usage = table.usage();
+	table.erase(0);
+	cout << "erase " << (table.usage() < usage) << endl;
+
+	cout << endl;
+	idle();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+﻿#include "Eterfree/Platform/Core/Endian.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <vector>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <WinSock2.h>
+#pragma comment(lib, "WS2_32.Lib")
+#else
+#include <arpa/inet.h>
+#endif
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+USING_PLATFORM_SPACE
+
+// 编译期求值
+static_assert(hton(static_cast<std::uint16_t>(0x0102)) == \
+	(little() ? 0x0201 : 0x0102));
+static_assert(ntoh<std::uint32_t, std::uint32_t>(hton(0x01020304U)) == 0x01020304U);
+static_assert(ntoh<std::uint64_t, double>(hton(0.5)) == 0.5);
+static_assert(BigEndian<std::uint32_t>(0x01020304U).load() == 0x01020304U);
+static_assert(sizeof(LittleEndian<double>) == sizeof(double) \
+	and alignof(LittleEndian<double>) == 1);
+
+// 原实现：非内联调用，16与32位调用htons与htonl，64位逐字节反转
+namespace Legacy
+{
+	template <typename _Type>
+	static _Type reverse(_Type _value) noexcept
+	{
+		auto begin = reinterpret_cast<char*>(&_value);
+		auto end = begin + sizeof _value;
+		std::reverse(begin, end);
+		return _value;
+	}
+
+	static bool little() noexcept
+	{
+		constexpr auto INTEGER = static_cast<std::uint16_t>(1);
+		return *reinterpret_cast<const char*>(&INTEGER) != '\0';
+	}
+
+	NOINLINE static std::uint16_t hton(std::uint16_t _value)
+	{
+		return htons(_value);
+	}
+
+	NOINLINE static std::uint32_t hton(std::uint32_t _value)
+	{
+		return htonl(_value);
+	}
+
+	NOINLINE static std::uint64_t hton(std::uint64_t _value)
+	{
+		return little() ? reverse(_value) : _value;
+	}
+
+	NOINLINE static std::uint64_t hton(double _value)
+	{
+		if (little())
+			_value = reverse(_value);
+
+		std::uint64_t value = 0;
+		std::memcpy(&value, &_value, sizeof value);
+		return value;
+	}
+}
+
+template <typename _Source, typename _Functor>
+static double benchmark(const std::vector<_Source>& _source, \
+	_Functor _functor, std::uint64_t& _result)
+{
+	constexpr auto ROUNDS = 64;
+
+	auto begin = std::chrono::steady_clock::now();
+
+	std::uint64_t result = 0;
+	for (auto round = 0; round < ROUNDS; ++round)
+		for (auto value : _source)
+			result += _functor(value);
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+
+	_result = result;
+	return duration.count() / (_source.size() * ROUNDS);
+}
+
+template <typename _Source, typename _Legacy, typename _Current>
+static void compare(const char* _name, const std::vector<_Source>& _source, \
+	_Legacy _legacy, _Current _current)
+{
+	using std::cout, std::endl;
+
+	std::uint64_t legacy = 0, current = 0;
+	auto before = benchmark(_source, _legacy, legacy);
+	auto after = benchmark(_source, _current, current);
+
+	cout << _name << ": legacy " << before << " ns, current " \
+		<< after << " ns, " << std::boolalpha \
+		<< "equal " << (legacy == current) << endl;
+}
+
+// 批量转换吞吐量，单位GB/s
+template <typename _Type, typename _Functor>
+static double throughput(std::vector<_Type>& _target, _Functor _functor)
+{
+	constexpr auto ROUNDS = 256;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (auto round = 0; round < ROUNDS; ++round)
+	{
+		_functor();
+
+		// 每轮读取结果，防止编译器合并重复之memcpy
+		volatile auto value = _target[_target.size() / 2];
+		(void)value;
+	}
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+	return _target.size() * sizeof(_Type) * ROUNDS / duration.count();
+}
+
+template <typename _Type>
+static void bulk(const char* _name, std::size_t _size)
+{
+	using std::cout, std::endl;
+
+	std::vector<_Type> source(_size), target(_size), expected(_size);
+	for (std::size_t index = 0; index < _size; ++index)
+	{
+		source[index] = static_cast<_Type>(index * 0x9E3779B97F4A7C15ULL);
+		expected[index] = static_cast<_Type>(hton(source[index]));
+	}
+
+	auto copy = throughput(target, [&]
+		{ std::memcpy(target.data(), source.data(), _size * sizeof(_Type)); });
+
+	auto scalar = throughput(target, [&]
+		{
+			for (std::size_t index = 0; index < _size; ++index)
+				target[index] = Legacy::hton(source[index]);
+		});
+
+	auto vector = throughput(target, [&]
+		{ hton(std::span(std::as_const(source)), std::span(target)); });
+	bool equal = target == expected;
+
+	hton(std::span(source));
+	equal = equal and source == expected;
+
+	cout << _name << ": memcpy " << copy << " GB/s, scalar " << scalar \
+		<< " GB/s, bulk " << vector << " GB/s, " << std::boolalpha \
+		<< "equal " << equal << endl;
+}
+
+int main()
+{
+	constexpr std::size_t SIZE = 1 << 20;
+
+	std::vector<std::uint32_t> integers(SIZE);
+	std::vector<std::uint64_t> longs(SIZE);
+	std::vector<double> doubles(SIZE);
+	for (std::size_t index = 0; index < SIZE; ++index)
+	{
+		integers[index] = static_cast<std::uint32_t>(index * 2654435761U);
+		longs[index] = index * 0x9E3779B97F4A7C15ULL;
+		doubles[index] = static_cast<double>(index) / 3;
+	}
+
+	compare("uint32", integers, \
+		[](std::uint32_t _value) { return Legacy::hton(_value); }, \
+		[](std::uint32_t _value) { return hton(_value); });
+	compare("uint64", longs, \
+		[](std::uint64_t _value) { return Legacy::hton(_value); }, \
+		[](std::uint64_t _value) { return hton(_value); });
+	compare("double", doubles, \
+		[](double _value) { return Legacy::hton(_value); }, \
+		[](double _value) { return hton(_value); });
+
+	// 一级缓存以内之数据
+	constexpr std::size_t BYTES = 16 << 10;
+
+	std::cout << std::endl;
+	bulk<std::uint16_t>("uint16[]", BYTES / sizeof(std::uint16_t));
+	bulk<std::uint32_t>("uint32[]", BYTES / sizeof(std::uint32_t));
+	bulk<std::uint64_t>("uint64[]", BYTES / sizeof(std::uint64_t));
+
+	auto value = ntoh<std::uint64_t, double>(hton(doubles[SIZE - 1]));
+	std::cout << "round trip: " << std::boolalpha \
+		<< (value == doubles[SIZE - 1]) << std::endl;
+	return EXIT_SUCCESS;
+}
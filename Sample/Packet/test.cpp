@@ -0,0 +1,397 @@
+﻿#include "Eterfree/Core/Packet.hpp"
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <span>
+#include <chrono>
+#include <iostream>
+
+USING_ETERFREE_SPACE
+
+using SizeType = ByteStream::SizeType;
+using Buffer = ByteStream::Buffer;
+
+static const char* SENTENCE = "不赌天意，不猜人心。";
+
+enum class Command : std::uint16_t
+{
+	LOGIN = 1,
+	MOVE = 2
+};
+
+struct Vector
+{
+	float _x, _y, _z;
+};
+
+// 无填充之定长结构
+struct State
+{
+	std::uint32_t _identity;
+	Command _command;
+	std::uint16_t _flag;
+	Vector _position;
+	std::array<std::int32_t, 5> _values;
+	double _time;
+};
+
+// 紧凑线上头部，直接覆盖于数据包内存
+struct Header
+{
+	Platform::BigEndian<Command> _command;
+	Platform::BigEndian<std::uint32_t> _identity;
+};
+
+static_assert(sizeof(Header) == 6 and alignof(Header) == 1);
+
+// 含填充之定长结构
+struct Login
+{
+	bool _guest;
+	std::uint32_t _identity;
+};
+
+// 含布尔之无填充结构
+struct Option
+{
+	bool _visible;
+	std::uint8_t _level;
+	std::array<bool, 2> _masks;
+};
+
+ETERFREE_SPACE_BEGIN
+
+template <>
+struct PacketLayout<Vector>
+{
+	static constexpr auto FIELDS = std::make_tuple(&Vector::_x, \
+		&Vector::_y, &Vector::_z);
+};
+
+template <>
+struct PacketLayout<State>
+{
+	static constexpr auto FIELDS = std::make_tuple(&State::_identity, \
+		&State::_command, &State::_flag, &State::_position, \
+		&State::_values, &State::_time);
+};
+
+template <>
+struct PacketLayout<Login>
+{
+	static constexpr auto FIELDS = std::make_tuple(&Login::_guest, \
+		&Login::_identity);
+};
+
+template <>
+struct PacketLayout<Option>
+{
+	static constexpr auto FIELDS = std::make_tuple(&Option::_visible, \
+		&Option::_level, &Option::_masks);
+};
+
+ETERFREE_SPACE_END
+
+static_assert(PacketTraits<State>::SIZE == sizeof(State));
+static_assert(PacketTraits<State>::PACKED);
+static_assert(PacketTraits<Login>::SIZE == 5);
+static_assert(not PacketTraits<Login>::PACKED);
+static_assert(not PacketTraits<Option>::PACKED);
+
+// 字节流往返：写入器组包，读取器解析
+static void transfer(bool _endian)
+{
+	using std::cout, std::endl;
+
+	OutputByteStream output;
+	InputByteStream input;
+
+	ByteStream::FlagType flag = 0;
+	ByteStream::setFlag(flag, ByteStream::FLAG_TYPE_ENDIAN, _endian);
+	output.replaceFlag(flag);
+	input.replaceFlag(flag);
+
+	std::array<float, 3> position = { 1.5F, -2.25F, 3.0F };
+
+	Buffer buffer;
+	PacketWriter writer(buffer, output, 64);
+	writer << Command::MOVE << std::uint32_t(42) << true \
+		<< std::int64_t(-7) << 0.5 << SENTENCE \
+		<< std::span(position);
+	output.put(buffer);
+
+	SizeType size = ByteStream::MAX_SIZE;
+	auto data = output.data(size);
+	input.put(data, size);
+	output.take(size);
+
+	Buffer packet;
+	input.take(packet);
+
+	Command command{};
+	std::uint32_t identity = 0;
+	bool enabled = false;
+	std::int64_t offset = 0;
+	double scale = 0;
+	std::string_view text;
+	std::array<float, 3> target = {};
+
+	if (_endian)
+	{
+		auto header = reinterpret_cast<const Header*>(packet.data());
+		cout << "header " << static_cast<int>(header->_command.load()) \
+			<< ' ' << header->_identity << endl;
+	}
+
+	PacketReader reader(packet, input);
+	reader >> command >> identity >> enabled \
+		>> offset >> scale >> text >> std::span(target);
+
+	cout << std::boolalpha << "endian " << _endian \
+		<< ", done " << reader.done() << endl;
+	cout << static_cast<int>(command) << ' ' << identity << ' ' \
+		<< enabled << ' ' << offset << ' ' << scale << ' ' << text << endl;
+	cout << target[0] << ' ' << target[1] << ' ' << target[2] << endl;
+
+	// 越界之后保持失败状态
+	std::uint64_t extra = 0;
+	reader >> extra >> identity;
+	cout << "overrun " << not reader.good() << ", extra " << extra << endl;
+
+	// 长度超出前缀范围则不写入，保持失败状态至清空
+	if constexpr (sizeof(SizeType) > sizeof(std::uint32_t))
+	{
+		writer.clear();
+		writer << std::string_view(SENTENCE, SizeType(1) << 32) \
+			<< std::uint8_t(1);
+		cout << "oversize " << not writer.good() << ", size " \
+			<< writer.size();
+
+		writer.clear();
+		cout << ", clear " << writer.good() << endl;
+	}
+}
+
+// 定长结构往返
+static void serialize(bool _endian)
+{
+	using std::cout, std::endl;
+
+	State state = { 7, Command::MOVE, 3, { 1.5F, -2.25F, 3.0F }, \
+		{ 1, -2, 3, -4, 5 }, 0.125 };
+	Login login = { true, 9 };
+
+	Buffer buffer;
+	PacketWriter writer(buffer, _endian);
+	writer << state << login;
+
+	State copy{};
+	Login other{};
+	PacketReader reader(buffer, _endian);
+	reader >> copy >> other;
+
+	bool equal = std::memcmp(&state, &copy, sizeof state) == 0 \
+		and other._guest == login._guest \
+		and other._identity == login._identity;
+	cout << std::boolalpha << "endian " << _endian \
+		<< ", size " << buffer.size() << ", contiguous " \
+		<< PacketTraits<State>::contiguous() << ", done " \
+		<< reader.done() << ", equal " << equal << endl;
+}
+
+// 位集合往返：字节序一致则整体复制
+static void bitmap(bool _endian)
+{
+	using std::cout, std::endl;
+
+	using SizeType = BitSet<std::uint64_t>::SizeType;
+
+	SizeType from = 70, to = 140;
+	BitSet<std::uint64_t> bitSet(4);
+	bitSet.set(3).set(from, to).flip(255);
+
+	Buffer buffer;
+	PacketWriter writer(buffer, _endian);
+	writer << bitSet;
+
+	BitSet<std::uint64_t> copy;
+	std::array<std::uint64_t, 8> words;
+	words.fill(~0ULL);
+
+	PacketReader reader(buffer, _endian);
+	reader >> copy;
+
+	PacketReader other(buffer, _endian);
+	other >> BitSetView(std::span(words));
+
+	// 元素不足之视图读取失败
+	std::array<std::uint64_t, 2> small = {};
+	PacketReader overflow(buffer, _endian);
+	overflow >> BitSetView(std::span(small));
+
+	cout << std::boolalpha << "bitmap endian " << _endian \
+		<< ", size " << buffer.size() << ", equal " \
+		<< (copy == bitSet and BitSetView(std::span(words)) == bitSet) \
+		<< ", done " << (reader.done() and other.done()) \
+		<< ", overflow " << not overflow.good() << endl;
+}
+
+// 线上非零字节解码为真
+static void boolean()
+{
+	using std::cout, std::endl;
+
+	const char bytes[] = { 2, 9, 0, 3, 5, 0, 4 };
+	std::string_view packet(bytes, sizeof bytes);
+
+	Option option = {};
+	std::array<bool, 3> flags = {};
+	PacketReader reader(packet, true);
+	reader >> option >> std::span(flags);
+
+	std::array<bool, 7> values = {};
+	PacketReader other(packet, false);
+	other >> std::span(values);
+
+	cout << std::boolalpha << "boolean " << static_cast<int>(option._visible) \
+		<< ' ' << static_cast<int>(option._level) << ' ' \
+		<< static_cast<int>(option._masks[0]) \
+		<< static_cast<int>(option._masks[1]) << ' ' \
+		<< static_cast<int>(flags[0]) << static_cast<int>(flags[1]) \
+		<< static_cast<int>(flags[2]) << ' ' \
+		<< static_cast<int>(values[0]) << static_cast<int>(values[6]) \
+		<< ", done " << (reader.done() and other.done()) << endl;
+}
+
+// 手工组包：逐字段转换并追加
+static void build(Buffer& _buffer, std::uint32_t _index)
+{
+	_buffer.clear();
+
+	auto command = Platform::hton(static_cast<std::uint16_t>(Command::LOGIN));
+	_buffer.append(reinterpret_cast<const char*>(&command), sizeof command);
+
+	auto index = Platform::hton(_index);
+	_buffer.append(reinterpret_cast<const char*>(&index), sizeof index);
+
+	auto scale = Platform::hton(_index * 0.5);
+	_buffer.append(reinterpret_cast<const char*>(&scale), sizeof scale);
+
+	auto length = Platform::hton(static_cast<std::uint32_t>(std::strlen(SENTENCE)));
+	_buffer.append(reinterpret_cast<const char*>(&length), sizeof length);
+	_buffer.append(SENTENCE);
+}
+
+template <typename _Functor>
+static double benchmark(_Functor _functor)
+{
+	constexpr std::uint32_t ROUNDS = 1 << 20;
+
+	auto begin = std::chrono::steady_clock::now();
+	SizeType size = 0;
+	for (std::uint32_t index = 0; index < ROUNDS; ++index)
+		size += _functor(index);
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+
+	volatile auto result = size;
+	(void)result;
+	return duration.count() / ROUNDS;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	transfer(true);
+	cout << endl;
+	transfer(false);
+	cout << endl;
+
+	auto manual = benchmark([](std::uint32_t _index)
+		{
+			Buffer buffer;
+			build(buffer, _index);
+			return buffer.size();
+		});
+
+	Buffer buffer;
+	auto writer = benchmark([&buffer](std::uint32_t _index)
+		{
+			PacketWriter writer(buffer, true, 64);
+			writer.clear();
+			writer << Command::LOGIN << _index \
+				<< _index * 0.5 << SENTENCE;
+			return writer.size();
+		});
+
+	auto reader = benchmark([&buffer](std::uint32_t)
+		{
+			PacketReader reader(buffer, true);
+			auto command = reader.read<Command>();
+			auto index = reader.read<std::uint32_t>();
+			auto scale = reader.read<double>();
+			std::string_view text;
+			reader.read(text);
+			return reader.done() ? static_cast<SizeType>(command) \
+				+ index + static_cast<SizeType>(scale) + text.size() : 0;
+		});
+
+	cout << "manual " << manual << " ns/packet, writer " << writer \
+		<< " ns/packet, reader " << reader << " ns/packet" << endl;
+
+	cout << endl;
+	serialize(true);
+	serialize(false);
+	bitmap(true);
+	bitmap(false);
+	boolean();
+
+	State state = { 7, Command::MOVE, 3, { 1.5F, -2.25F, 3.0F }, \
+		{ 1, -2, 3, -4, 5 }, 0.125 };
+
+	// 手工逐字段转换
+	auto fields = benchmark([&buffer, &state](std::uint32_t _index)
+		{
+			buffer.clear();
+			state._identity = _index;
+
+			auto append = [&buffer](auto _value)
+			{
+				auto value = Platform::hton(_value);
+				buffer.append(reinterpret_cast<const char*>(&value), sizeof value);
+			};
+
+			append(state._identity);
+			append(static_cast<std::uint16_t>(state._command));
+			append(state._flag);
+			append(state._position._x);
+			append(state._position._y);
+			append(state._position._z);
+			for (auto value : state._values)
+				append(value);
+			append(state._time);
+			return buffer.size();
+		});
+
+	auto encode = [&buffer, &state](bool _endian)
+	{
+		return benchmark([&buffer, &state, _endian](std::uint32_t _index)
+			{
+				state._identity = _index;
+				PacketWriter writer(buffer, _endian);
+				writer.clear();
+				writer << state;
+				return writer.size();
+			});
+	};
+
+	auto swapped = encode(true);
+	auto native = encode(false);
+	cout << "struct: manual " << fields << " ns, swapped " << swapped \
+		<< " ns, native " << native << " ns" << endl;
+	return EXIT_SUCCESS;
+}
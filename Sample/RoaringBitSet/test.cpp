@@ -0,0 +1,237 @@
+﻿#include "Eterfree/Core/RoaringBitSet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <set>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <iostream>
+
+USING_ETERFREE_SPACE
+
+using SizeType = RoaringBitSet::SizeType;
+using Reference = std::set<SizeType>;
+
+// 对照有序集合
+static bool equal(const RoaringBitSet& _bitSet, const Reference& _reference)
+{
+	if (_bitSet.count() != _reference.size()) return false;
+
+	if (not std::equal(_bitSet.begin(), _bitSet.end(), \
+		_reference.begin(), _reference.end()))
+		return false;
+
+	for (auto position : _reference)
+		if (not _bitSet[position]) return false;
+	return true;
+}
+
+// 随机操作对照，覆盖数组、位图与游程容器
+static bool verify()
+{
+	std::mt19937 engine(41);
+
+	// 少量块，部分块超过数组上限
+	auto random = [&engine]
+	{
+		auto key = engine() % 4;
+		auto range = key < 2 ? 8192 : 65536;
+		return static_cast<SizeType>(key << 16 | engine() % range);
+	};
+
+	RoaringBitSet left, right;
+	Reference leftReference, rightReference;
+	for (auto round = 0; round < 40000; ++round)
+	{
+		auto position = random();
+		auto operation = engine() % 4;
+		auto& bitSet = round % 2 == 0 ? left : right;
+		auto& reference = round % 2 == 0 ? leftReference : rightReference;
+		if (operation < 2)
+		{
+			bitSet.set(position);
+			reference.insert(position);
+		}
+		else if (operation == 2)
+		{
+			bitSet.reset(position);
+			reference.erase(position);
+		}
+		else
+		{
+			bitSet.flip(position);
+			if (not reference.erase(position))
+				reference.insert(position);
+		}
+	}
+
+	// 连续区间，便于游程
+	for (SizeType position = 5 << 16; position < (5 << 16) + 30000; ++position)
+	{
+		left.set(position);
+		leftReference.insert(position);
+	}
+
+	if (not equal(left, leftReference) or not equal(right, rightReference))
+		return false;
+
+	auto check = [&](const RoaringBitSet& _left, const RoaringBitSet& _right)
+	{
+		Reference reference;
+		std::set_intersection(leftReference.begin(), leftReference.end(), \
+			rightReference.begin(), rightReference.end(), \
+			std::inserter(reference, reference.end()));
+		if (not equal(_left & _right, reference)) return false;
+
+		reference.clear();
+		std::set_union(leftReference.begin(), leftReference.end(), \
+			rightReference.begin(), rightReference.end(), \
+			std::inserter(reference, reference.end()));
+		if (not equal(_left | _right, reference)) return false;
+
+		reference.clear();
+		std::set_symmetric_difference(leftReference.begin(), leftReference.end(), \
+			rightReference.begin(), rightReference.end(), \
+			std::inserter(reference, reference.end()));
+		return equal(_left ^ _right, reference);
+	};
+
+	if (not check(left, right)) return false;
+
+	// 游程容器参与运算
+	auto optimized = left;
+	optimized.optimize();
+	if (not (optimized == left) or not equal(optimized, leftReference))
+		return false;
+	if (not check(optimized, right)) return false;
+
+	// 查找与复制
+	SizeType begin = 3 << 16 | 100, end = 6 << 16;
+	auto iterator = leftReference.lower_bound(begin);
+	if (left.find(begin) != *iterator) return false;
+
+	Reference reference;
+	for (; iterator != leftReference.end() and *iterator < end; ++iterator)
+		reference.insert(*iterator - begin);
+	if (not equal(optimized.copy(begin, end), reference)) return false;
+
+	// 稠密位集合互相转换
+	auto dense = left.dense<std::uint64_t>();
+	if (dense.count() != leftReference.size() \
+		or not (RoaringBitSet(dense) == left))
+		return false;
+
+	// 位置超过2^31，块键须按SizeType移位
+	SizeType position = 0x80000005;
+	RoaringBitSet high;
+	high.set(position);
+	if (*high.begin() != position or high.find(4) != position)
+		return false;
+
+	auto copied = high.copy(0x80000000, 0x80000010);
+	if (copied.count() != 1 or not copied[5]) return false;
+
+	auto highDense = high.dense<std::uint64_t>();
+	return highDense.count() == 1 \
+		and RoaringBitSet(highDense) == high;
+}
+
+// 随机位置
+static std::vector<SizeType> generate(std::mt19937_64& _engine, \
+	SizeType _size, SizeType _range)
+{
+	std::vector<SizeType> positions(_size);
+	for (auto& position : positions)
+		position = _engine() % _range;
+	return positions;
+}
+
+// 比较稠密位集合与压缩位集合之内存占用与求交耗时
+static void benchmark(const char* _name, SizeType _size, SizeType _range)
+{
+	using std::cout, std::endl;
+
+	using BitSet = BitSet<std::uint64_t>;
+
+	constexpr auto ROUNDS = 16;
+
+	std::mt19937_64 engine(_size);
+	auto left = generate(engine, _size, _range);
+	auto right = generate(engine, _size, _range);
+
+	// 半数重叠
+	std::copy(left.begin(), left.begin() + _size / 2, right.begin());
+
+	BitSet leftDense, rightDense;
+	RoaringBitSet leftRoaring, rightRoaring;
+	for (auto position : left)
+	{
+		leftDense.set(position);
+		leftRoaring.set(position);
+	}
+
+	for (auto position : right)
+	{
+		rightDense.set(position);
+		rightRoaring.set(position);
+	}
+
+	auto measure = [](auto _functor)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (auto round = 0; round < ROUNDS; ++round)
+			_functor();
+
+		std::chrono::duration<double, std::micro> duration = \
+			std::chrono::steady_clock::now() - begin;
+		return duration.count() / ROUNDS;
+	};
+
+	SizeType denseCount = 0, roaringCount = 0;
+	auto denseTime = measure([&]
+		{ denseCount = (leftDense & rightDense).count(); });
+	auto roaringTime = measure([&]
+		{ roaringCount = (leftRoaring & rightRoaring).count(); });
+
+	auto denseUsage = sizeof(BitSet::ValueType) * leftDense.size();
+	cout << _name << ": dense " << denseUsage / 1024 << " KiB " \
+		<< denseTime << " us, roaring " << leftRoaring.usage() / 1024 \
+		<< " KiB " << roaringTime << " us, " << std::boolalpha \
+		<< (denseCount == roaringCount) << endl;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	cout << "verify: " << std::boolalpha << verify() << endl;
+
+	// 订阅编号：四千个位置散布于三十二位范围，稠密位集合需五百一十二兆字节
+	std::mt19937_64 engine(4096);
+	RoaringBitSet subscriptions;
+	for (auto position : generate(engine, 4096, SizeType(1) << 32))
+		subscriptions.set(position);
+	cout << "subscriptions: " << subscriptions.count() << " bits, " \
+		<< subscriptions.chunks() << " chunks, " \
+		<< subscriptions.usage() / 1024 << " KiB, dense " \
+		<< (SizeType(1) << 32) / CHAR_BIT / 1024 / 1024 << " MiB" << endl;
+
+	benchmark("sparse", 4096, SizeType(1) << 28);
+	benchmark("dense", SizeType(1) << 20, SizeType(1) << 24);
+
+	// 连续区间转换为游程
+	RoaringBitSet ranges;
+	for (SizeType position = 0; position < (SizeType(1) << 24); ++position)
+		if (position % 100000 < 50000) ranges.set(position);
+
+	auto usage = ranges.usage();
+	ranges.optimize();
+	cout << "runs: " << usage / 1024 << " KiB -> " \
+		<< ranges.usage() / 1024 << " KiB, count " \
+		<< ranges.count() << endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+﻿#include "Eterfree/Core/SlabResource.h"
+#include "Eterfree/Core/ByteStream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <memory_resource>
+
+USING_ETERFREE_SPACE
+
+using SizeType = SlabResource::SizeType;
+
+// 已分配之内存块
+struct Block
+{
+	char* _data;
+	SizeType _size;
+	SizeType _alignment;
+};
+
+// 随机分配与释放，内容互不覆盖且满足对齐，全部释放后归还所有块
+static bool verify()
+{
+	constexpr SizeType ALIGNMENTS[] = { 1, 8, 64, 128 };
+
+	SlabResource resource(16 * 1024);
+	std::mt19937_64 engine(resource.maxSize());
+	std::vector<Block> blocks;
+
+	auto check = [](const Block& _block)
+	{
+		auto value = static_cast<char>(_block._size);
+		for (SizeType index = 0; index < _block._size; ++index)
+			if (_block._data[index] != value) return false;
+		return true;
+	};
+
+	for (auto round = 0; round < 100000; ++round)
+	{
+		if (not blocks.empty() and engine() % 2 == 0)
+		{
+			auto index = engine() % blocks.size();
+			auto block = blocks[index];
+			if (not check(block)) return false;
+
+			resource.deallocate(block._data, block._size, block._alignment);
+			blocks[index] = blocks.back();
+			blocks.pop_back();
+			continue;
+		}
+
+		// 多为小块，偶尔为大块或超出最大尺寸等级
+		auto limit = engine() % 4 == 0 ? resource.maxSize() : 3000;
+		SizeType size = engine() % 64 == 0 ? \
+			resource.maxSize() + engine() % 4096 : 1 + engine() % limit;
+		auto alignment = ALIGNMENTS[engine() % std::size(ALIGNMENTS)];
+
+		auto data = static_cast<char*>(resource.allocate(size, alignment));
+		if (reinterpret_cast<std::uintptr_t>(data) % alignment != 0)
+			return false;
+
+		std::memset(data, static_cast<char>(size), size);
+		blocks.push_back({ data, size, alignment });
+	}
+
+	for (const auto& block : blocks)
+	{
+		if (not check(block)) return false;
+		resource.deallocate(block._data, block._size, block._alignment);
+	}
+
+	if (resource.usage() <= 0 or resource.allocated() != 0)
+		return false;
+
+	// 每级保留一个空闲块，再次分配无需上游
+	resource.trim(1);
+	auto usage = resource.usage();
+	auto data = resource.allocate(SlabResource::MIN_SIZE);
+	bool reused = usage > 0 and resource.usage() == usage \
+		and resource.allocated() == SlabResource::MIN_SIZE;
+	resource.deallocate(data, SlabResource::MIN_SIZE);
+
+	resource.trim();
+	return reused and resource.usage() == 0;
+}
+
+// 字节流之收发缓冲自分块内存资源分配
+static bool stream()
+{
+	SlabResource resource;
+	OutputByteStream output(0, 0, &resource);
+	InputByteStream input(0, 0, &resource);
+	input.alignment(ByteStream::MAX_ALIGNMENT);
+	output.alignment(ByteStream::MAX_ALIGNMENT);
+
+	std::vector<ByteStream::Buffer> packets;
+	for (SizeType index = 0; index < 256; ++index)
+	{
+		packets.emplace_back(index * 7 % 1500, static_cast<char>(index));
+		if (not output.put(packets.back())) return false;
+	}
+
+	ByteStream::SizeType size = ByteStream::MAX_SIZE;
+	auto data = output.data(size);
+	if (resource.usage() <= 0) return false;
+
+	// 分段输入，接收缓冲多次增长
+	for (ByteStream::SizeType offset = 0; offset < size; offset += 1000)
+		if (not input.put(data + offset, std::min<ByteStream::SizeType>(1000, size - offset)))
+			return false;
+	output.take(size);
+
+	ByteStream::Buffer packet;
+	for (const auto& expected : packets)
+		if (not input.take(packet) or packet != expected)
+			return false;
+
+	output.trim();
+	input.trim();
+	resource.trim();
+	return input.empty() and output.empty() and resource.usage() == 0;
+}
+
+// 若干尺寸等级之数据包缓冲：释放最早者并分配新者，单位为纳秒
+static double benchmark(std::pmr::memory_resource& _resource)
+{
+	constexpr SizeType SIZES[] = { 64, 200, 576, 1500, 4096, 9000 };
+	constexpr SizeType LIVE = 4096;
+	constexpr SizeType ROUNDS = 1 << 21;
+
+	std::mt19937 engine(LIVE);
+	std::vector<SizeType> sizes(ROUNDS);
+	for (auto& size : sizes)
+		size = SIZES[engine() % std::size(SIZES)];
+
+	std::vector<Block> blocks(LIVE);
+	for (SizeType index = 0; index < LIVE; ++index)
+	{
+		auto size = sizes[index];
+		blocks[index] = { static_cast<char*>(_resource.allocate(size)), size, alignof(std::max_align_t) };
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	for (SizeType round = 0; round < ROUNDS; ++round)
+	{
+		auto& block = blocks[round % LIVE];
+		_resource.deallocate(block._data, block._size);
+
+		block._size = sizes[round];
+		block._data = static_cast<char*>(_resource.allocate(block._size));
+		block._data[0] = static_cast<char>(round);
+	}
+
+	std::chrono::duration<double, std::nano> duration = \
+		std::chrono::steady_clock::now() - begin;
+
+	for (const auto& block : blocks)
+		_resource.deallocate(block._data, block._size);
+	return duration.count() / ROUNDS;
+}
+
+int main()
+{
+	using std::cout, std::endl;
+
+	cout << std::boolalpha << "verify: " << verify() << endl;
+	cout << "stream: " << stream() << endl;
+
+	std::pmr::unsynchronized_pool_resource pool;
+	SlabResource slab;
+
+	cout << "new delete: " << benchmark(*std::pmr::new_delete_resource()) \
+		<< " ns, pool: " << benchmark(pool) \
+		<< " ns, slab: " << benchmark(slab) << " ns" << endl;
+
+	cout << "slab usage " << slab.usage() / 1024 << " KiB";
+	slab.trim();
+	cout << ", after trim " << slab.usage() / 1024 << " KiB" << endl;
+	return EXIT_SUCCESS;
+}
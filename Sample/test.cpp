@@ -1,5 +1,13 @@
 ﻿#define STREAM 1
 #define BIT_SET 2
+#define CONNECTION_TABLE 3
+#define ENDIAN 4
+#define PACKET 5
+#define ROARING_BIT_SET 6
+#define ATOMIC_BIT_SET 7
+#define BIT_PARALLEL 8
+#define BLOOM_FILTER 9
+#define SLAB_RESOURCE 10
 
 #define TEST STREAM
 
@@ -8,4 +16,28 @@
 
 #elif TEST == BIT_SET
 #include "BitSet/test.cpp"
+
+#elif TEST == CONNECTION_TABLE
+#include "ConnectionTable/test.cpp"
+
+#elif TEST == ENDIAN
+#include "Endian/test.cpp"
+
+#elif TEST == PACKET
+#include "Packet/test.cpp"
+
+#elif TEST == ROARING_BIT_SET
+#include "RoaringBitSet/test.cpp"
+
+#elif TEST == ATOMIC_BIT_SET
+#include "AtomicBitSet/test.cpp"
+
+#elif TEST == BIT_PARALLEL
+#include "BitParallel/test.cpp"
+
+#elif TEST == BLOOM_FILTER
+#include "BloomFilter/test.cpp"
+
+#elif TEST == SLAB_RESOURCE
+#include "SlabResource/test.cpp"
 #endif
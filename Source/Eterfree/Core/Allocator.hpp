@@ -0,0 +1,125 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <memory_resource>
+
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+// 按指定字节对齐分配内存之分配器，对齐须为二之幂
+template <typename _Type, std::size_t _ALIGNMENT>
+class AlignedAllocator
+{
+	static_assert(_ALIGNMENT > 0 and (_ALIGNMENT & (_ALIGNMENT - 1)) == 0, \
+		"The alignment is not a power of two.");
+
+public:
+	using value_type = _Type;
+
+	template <typename _Other>
+	struct rebind
+	{
+		using other = AlignedAllocator<_Other, _ALIGNMENT>;
+	};
+
+	static constexpr auto ALIGNMENT = _ALIGNMENT \
+		> alignof(_Type) ? _ALIGNMENT : alignof(_Type);
+
+public:
+	AlignedAllocator() noexcept = default;
+
+	template <typename _Other>
+	AlignedAllocator(const AlignedAllocator<_Other, _ALIGNMENT>&) noexcept {}
+
+	_Type* allocate(std::size_t _size)
+	{
+		if (_size > std::numeric_limits<std::size_t>::max() / sizeof(_Type))
+			throw std::bad_array_new_length();
+
+		auto pointer = ::operator new(_size * sizeof(_Type), \
+			std::align_val_t(ALIGNMENT));
+		return static_cast<_Type*>(pointer);
+	}
+
+	void deallocate(_Type* _pointer, std::size_t _size) noexcept
+	{
+		::operator delete(_pointer, _size * sizeof(_Type), \
+			std::align_val_t(ALIGNMENT));
+	}
+
+	template <typename _Other>
+	bool operator==(const AlignedAllocator<_Other, _ALIGNMENT>&) const noexcept
+	{
+		return true;
+	}
+};
+
+/*
+ * 自内存资源按指定字节对齐分配之分配器，对齐须为二之幂。
+ * 缺省使用默认内存资源；容器之间移动或交换时不传播，内存资源相同方可交换。
+ */
+template <typename _Type, std::size_t _ALIGNMENT>
+class ResourceAllocator
+{
+	static_assert(_ALIGNMENT > 0 and (_ALIGNMENT & (_ALIGNMENT - 1)) == 0, \
+		"The alignment is not a power of two.");
+
+	template <typename, std::size_t>
+	friend class ResourceAllocator;
+
+public:
+	using value_type = _Type;
+
+	template <typename _Other>
+	struct rebind
+	{
+		using other = ResourceAllocator<_Other, _ALIGNMENT>;
+	};
+
+	static constexpr auto ALIGNMENT = _ALIGNMENT \
+		> alignof(_Type) ? _ALIGNMENT : alignof(_Type);
+
+private:
+	std::pmr::memory_resource* _resource;
+
+public:
+	ResourceAllocator() noexcept : \
+		_resource(std::pmr::get_default_resource()) {}
+
+	ResourceAllocator(std::pmr::memory_resource* _resource) noexcept : \
+		_resource(_resource) {}
+
+	template <typename _Other>
+	ResourceAllocator(const ResourceAllocator<_Other, _ALIGNMENT>& _allocator) noexcept : \
+		_resource(_allocator._resource) {}
+
+	auto resource() const noexcept
+	{
+		return _resource;
+	}
+
+	_Type* allocate(std::size_t _size)
+	{
+		if (_size > std::numeric_limits<std::size_t>::max() / sizeof(_Type))
+			throw std::bad_array_new_length();
+
+		auto pointer = _resource->allocate(_size * sizeof(_Type), ALIGNMENT);
+		return static_cast<_Type*>(pointer);
+	}
+
+	void deallocate(_Type* _pointer, std::size_t _size) noexcept
+	{
+		_resource->deallocate(_pointer, _size * sizeof(_Type), ALIGNMENT);
+	}
+
+	template <typename _Other>
+	bool operator==(const ResourceAllocator<_Other, _ALIGNMENT>& _allocator) const noexcept
+	{
+		return *_resource == *_allocator._resource;
+	}
+};
+
+ETERFREE_SPACE_END
@@ -0,0 +1,305 @@
+﻿#pragma once
+
+#include <bit>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <climits>
+#include <type_traits>
+#include <vector>
+
+#include "Allocator.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 原子位集合：容量于构造时确定，元素为原子字，单个位之操作无锁且线程安全。
+ * 范围操作逐字原子执行，整体不具原子性。
+ * 紧凑布局之元素连续存储且按缓存行对齐，不同线程宜以缓存行位数量划分区域；
+ * 填充布局之每个元素独占缓存行，避免相邻元素之伪共享。
+ */
+template <std::unsigned_integral _ValueType, bool _PADDED = false>
+class AtomicBitSet final
+{
+public:
+	using ValueType = _ValueType;
+	using SizeType = std::size_t;
+
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	// 缓存行字节数
+	static constexpr SizeType CACHE_LINE = 64;
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+	// 缓存行内之位数量，填充布局为单元素之位数量
+	static constexpr SizeType LINE_BITS = \
+		_PADDED ? BIT_SIZE : CACHE_LINE * CHAR_BIT;
+
+private:
+	using Atomic = std::atomic<ValueType>;
+
+	// 独占缓存行之元素
+	struct alignas(CACHE_LINE) Padded
+	{
+		Atomic _word;
+	};
+
+	using Element = std::conditional_t<_PADDED, Padded, Atomic>;
+	using Vector = std::vector<Element, \
+		AlignedAllocator<Element, CACHE_LINE>>;
+
+	// 单元素最大值
+	static constexpr ValueType MAX_ELEMENT = \
+		~static_cast<ValueType>(0);
+
+private:
+	SizeType _capacity; // 位数量
+	Vector _vector; // 元素向量
+
+private:
+	static constexpr ValueType generate(SizeType _position) noexcept
+	{
+		return static_cast<ValueType>(1) << _position % BIT_SIZE;
+	}
+
+	// 单元素之有效位掩码，末元素不含超出容量之位
+	ValueType mask(SizeType _index) const noexcept
+	{
+		auto remain = _capacity - _index * BIT_SIZE;
+		return remain >= BIT_SIZE ? MAX_ELEMENT \
+			: static_cast<ValueType>(MAX_ELEMENT >> (BIT_SIZE - remain));
+	}
+
+	Atomic& word(SizeType _index) noexcept
+	{
+		if constexpr (_PADDED) return _vector[_index]._word;
+		else return _vector[_index];
+	}
+
+	const Atomic& word(SizeType _index) const noexcept
+	{
+		if constexpr (_PADDED) return _vector[_index]._word;
+		else return _vector[_index];
+	}
+
+	// 逐字对指定范围执行原子操作，返回改变之位数量
+	template <typename _Operation>
+	SizeType traverse(SizeType _begin, SizeType _end, \
+		_Operation _operation, std::memory_order _order) noexcept;
+
+public:
+	explicit AtomicBitSet(SizeType _capacity) : \
+		_capacity(_capacity), \
+		_vector((_capacity + BIT_SIZE - 1) / BIT_SIZE) {}
+
+	AtomicBitSet(const AtomicBitSet&) = delete;
+
+	AtomicBitSet& operator=(const AtomicBitSet&) = delete;
+
+	bool operator[](SizeType _position) const noexcept
+	{
+		return exist(_position);
+	}
+
+	// 位数量
+	auto capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	// 元素数量
+	auto size() const noexcept
+	{
+		return _vector.size();
+	}
+
+	bool exist(SizeType _position, \
+		std::memory_order _order = std::memory_order::acquire) const noexcept
+	{
+		if (_position >= _capacity) return false;
+
+		auto element = word(_position / BIT_SIZE).load(_order);
+		return (element & generate(_position)) != 0;
+	}
+
+	// 设置指定位，返回原值
+	bool testAndSet(SizeType _position, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		if (_position >= _capacity) return false;
+
+		auto bit = generate(_position);
+		return (word(_position / BIT_SIZE).fetch_or(bit, _order) & bit) != 0;
+	}
+
+	// 重置指定位，返回原值
+	bool testAndReset(SizeType _position, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		if (_position >= _capacity) return false;
+
+		auto bit = generate(_position);
+		auto mask = static_cast<ValueType>(~bit);
+		return (word(_position / BIT_SIZE).fetch_and(mask, _order) & bit) != 0;
+	}
+
+	// 翻转指定位，返回原值
+	bool testAndFlip(SizeType _position, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		if (_position >= _capacity) return false;
+
+		auto bit = generate(_position);
+		return (word(_position / BIT_SIZE).fetch_xor(bit, _order) & bit) != 0;
+	}
+
+	// 设置指定范围，返回由零变一之位数量
+	SizeType set(SizeType _begin, SizeType _end, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		return traverse(_begin, _end, \
+			[](Atomic& _word, ValueType _mask, std::memory_order _order)
+			{
+				auto element = _word.fetch_or(_mask, _order);
+				return static_cast<ValueType>(~element & _mask);
+			}, _order);
+	}
+
+	// 重置指定范围，返回由一变零之位数量
+	SizeType reset(SizeType _begin, SizeType _end, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		return traverse(_begin, _end, \
+			[](Atomic& _word, ValueType _mask, std::memory_order _order)
+			{
+				auto element = _word.fetch_and(static_cast<ValueType>(~_mask), _order);
+				return static_cast<ValueType>(element & _mask);
+			}, _order);
+	}
+
+	// 翻转指定范围，返回翻转之位数量
+	SizeType flip(SizeType _begin, SizeType _end, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept
+	{
+		return traverse(_begin, _end, \
+			[](Atomic& _word, ValueType _mask, std::memory_order _order)
+			{
+				_word.fetch_xor(_mask, _order);
+				return _mask;
+			}, _order);
+	}
+
+	// 重置所有位
+	void reset(std::memory_order _order = std::memory_order::release) noexcept
+	{
+		for (SizeType index = 0; index < size(); ++index)
+			word(index).store(0, _order);
+	}
+
+	// 统计有效位，并发修改时为近似快照
+	SizeType count(std::memory_order _order = \
+		std::memory_order::relaxed) const noexcept
+	{
+		SizeType counter = 0;
+		for (SizeType index = 0; index < size(); ++index)
+			counter += std::popcount(word(index).load(_order));
+		return counter;
+	}
+
+	bool all() const noexcept
+	{
+		return count() == _capacity;
+	}
+
+	bool any() const noexcept
+	{
+		for (SizeType index = 0; index < size(); ++index)
+			if (word(index).load(std::memory_order::relaxed) != 0)
+				return true;
+		return false;
+	}
+
+	bool none() const noexcept
+	{
+		return not any();
+	}
+
+	/*
+	 * 无锁占用首个零位：自_hint所在元素起循环查找，比较交换成功则返回位置，
+	 * 所有位皆有效则返回NPOS。不同线程以不同提示起步，可减少争用与伪共享。
+	 */
+	SizeType claim(SizeType _hint = 0, \
+		std::memory_order _order = std::memory_order::acq_rel) noexcept;
+
+	// 释放占用之位，返回是否曾占用
+	bool release(SizeType _position, \
+		std::memory_order _order = std::memory_order::release) noexcept
+	{
+		return testAndReset(_position, _order);
+	}
+};
+
+// 逐字对指定范围执行原子操作
+template <std::unsigned_integral _ValueType, bool _PADDED>
+template <typename _Operation>
+auto AtomicBitSet<_ValueType, _PADDED>::traverse(SizeType _begin, \
+	SizeType _end, _Operation _operation, \
+	std::memory_order _order) noexcept -> SizeType
+{
+	if (_end > _capacity) _end = _capacity;
+	if (_begin >= _end) return 0;
+
+	auto begin = _begin / BIT_SIZE;
+	auto end = (_end - 1) / BIT_SIZE;
+
+	SizeType counter = 0;
+	for (auto index = begin; index <= end; ++index)
+	{
+		auto mask = MAX_ELEMENT;
+		if (index == begin)
+			mask &= static_cast<ValueType>(MAX_ELEMENT << _begin % BIT_SIZE);
+
+		if (index == end)
+			mask &= static_cast<ValueType>(MAX_ELEMENT \
+				>> (BIT_SIZE - 1 - (_end - 1) % BIT_SIZE));
+
+		counter += std::popcount(_operation(word(index), mask, _order));
+	}
+	return counter;
+}
+
+// 无锁占用首个零位
+template <std::unsigned_integral _ValueType, bool _PADDED>
+auto AtomicBitSet<_ValueType, _PADDED>::claim(SizeType _hint, \
+	std::memory_order _order) noexcept -> SizeType
+{
+	auto size = this->size();
+	if (size <= 0) return NPOS;
+
+	auto start = _hint / BIT_SIZE % size;
+	for (SizeType offset = 0; offset < size; ++offset)
+	{
+		auto index = start + offset;
+		if (index >= size) index -= size;
+
+		auto& word = this->word(index);
+		auto mask = this->mask(index);
+
+		// 失败时重新加载，仍有零位则继续尝试
+		auto element = word.load(std::memory_order::relaxed);
+		while (auto free = static_cast<ValueType>(~element & mask))
+		{
+			auto bit = static_cast<ValueType>(free & (0 - free));
+			if (word.compare_exchange_weak(element, element | bit, \
+				_order, std::memory_order::relaxed))
+				return index * BIT_SIZE + std::countr_zero(bit);
+		}
+	}
+	return NPOS;
+}
+
+ETERFREE_SPACE_END
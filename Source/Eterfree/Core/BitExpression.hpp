@@ -0,0 +1,248 @@
+﻿#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "BitKernel.h"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+template <std::unsigned_integral _ValueType>
+class BitSet;
+
+// 二元表达式类型
+enum BIT_EXPRESSION_TYPE : std::uint8_t
+{
+	BIT_EXPRESSION_AND,
+	BIT_EXPRESSION_OR,
+	BIT_EXPRESSION_XOR
+};
+
+/*
+ * 位表达式之公共操作：惰性求值，逐元素融合所有运算，不生成中间位集合。
+ * 派生类提供size、bound、at与element：
+ * size为结果元素数量，bound以内之元素可由at无边界检查求值，
+ * element检查边界，超出操作数之元素视为零。
+ * 表达式仅引用操作数，auto推导所得为表达式而非位集合，
+ * 操作数之修改可见，须在操作数生命周期内以eval或赋值求值。
+ */
+template <typename _Derived, std::unsigned_integral _ValueType>
+class BitExpressionBase
+{
+public:
+	using ValueType = _ValueType;
+	using SizeType = std::size_t;
+
+private:
+	constexpr const _Derived& derived() const noexcept
+	{
+		return static_cast<const _Derived&>(*this);
+	}
+
+public:
+	// 写入[_begin, _end)之元素，_data可与操作数相同
+	constexpr void evaluate(ValueType* _data, \
+		SizeType _begin, SizeType _end) const noexcept
+	{
+		auto& expression = derived();
+		auto bound = std::min(expression.bound(), _end);
+
+		auto index = _begin;
+		for (; index < bound; ++index)
+			*_data++ = expression.at(index);
+
+		for (; index < _end; ++index)
+			*_data++ = expression.element(index);
+	}
+
+	constexpr void evaluate(ValueType* _data) const noexcept
+	{
+		evaluate(_data, 0, derived().size());
+	}
+
+	// 求值为位集合，不再引用操作数
+	BitSet<ValueType> eval() const
+	{
+		return BitSet<ValueType>(derived());
+	}
+
+	// 统计[_begin, _end)之有效位：分段求值至栈缓冲，由统计内核处理，不生成结果
+	SizeType count(SizeType _begin, SizeType _end) const noexcept
+	{
+		constexpr SizeType CHUNK_SIZE = 1024 / sizeof(ValueType);
+
+		ValueType buffer[CHUNK_SIZE];
+
+		SizeType counter = 0;
+		for (auto index = _begin; index < _end; index += CHUNK_SIZE)
+		{
+			auto end = std::min(index + CHUNK_SIZE, _end);
+			evaluate(buffer, index, end);
+			counter += countBit(buffer, sizeof(ValueType) * (end - index));
+		}
+		return counter;
+	}
+
+	SizeType count() const noexcept
+	{
+		return count(0, derived().size());
+	}
+
+	constexpr bool any() const noexcept
+	{
+		auto& expression = derived();
+		for (SizeType index = 0; index < expression.size(); ++index)
+			if (expression.element(index) != 0) return true;
+		return false;
+	}
+
+	constexpr bool none() const noexcept
+	{
+		return not any();
+	}
+};
+
+template <typename _Type>
+concept BitExpressionType = std::derived_from<_Type, \
+	BitExpressionBase<_Type, typename _Type::ValueType>>;
+
+// 叶节点：引用外部元素，生命周期不超过元素
+template <std::unsigned_integral _ValueType>
+class BitLeaf final : \
+	public BitExpressionBase<BitLeaf<_ValueType>, _ValueType>
+{
+public:
+	using ValueType = _ValueType;
+	using SizeType = std::size_t;
+
+private:
+	const ValueType* _data;
+	SizeType _size;
+
+public:
+	constexpr BitLeaf(const ValueType* _data, SizeType _size) noexcept : \
+		_data(_data), _size(_size) {}
+
+	constexpr auto size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr auto bound() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr ValueType at(SizeType _index) const noexcept
+	{
+		return _data[_index];
+	}
+
+	constexpr ValueType element(SizeType _index) const noexcept
+	{
+		return _index < _size ? _data[_index] : 0;
+	}
+};
+
+// 二元表达式：结果元素数量为较长操作数之元素数量
+template <BIT_EXPRESSION_TYPE _TYPE, typename _Left, typename _Right>
+class BitExpression final : \
+	public BitExpressionBase<BitExpression<_TYPE, _Left, _Right>, \
+		typename _Left::ValueType>
+{
+	static_assert(std::is_same_v<typename _Left::ValueType, \
+		typename _Right::ValueType>, \
+		"The value types of operands are different.");
+
+public:
+	using ValueType = typename _Left::ValueType;
+	using SizeType = std::size_t;
+
+private:
+	_Left _left;
+	_Right _right;
+
+private:
+	static constexpr ValueType apply(ValueType _left, \
+		ValueType _right) noexcept
+	{
+		if constexpr (_TYPE == BIT_EXPRESSION_AND)
+			return static_cast<ValueType>(_left & _right);
+		else if constexpr (_TYPE == BIT_EXPRESSION_OR)
+			return static_cast<ValueType>(_left | _right);
+		else
+			return static_cast<ValueType>(_left ^ _right);
+	}
+
+public:
+	constexpr BitExpression(const _Left& _left, \
+		const _Right& _right) noexcept : \
+		_left(_left), _right(_right) {}
+
+	constexpr SizeType size() const noexcept
+	{
+		return std::max(_left.size(), _right.size());
+	}
+
+	constexpr SizeType bound() const noexcept
+	{
+		return std::min(_left.bound(), _right.bound());
+	}
+
+	constexpr ValueType at(SizeType _index) const noexcept
+	{
+		return apply(_left.at(_index), _right.at(_index));
+	}
+
+	// 零与零之运算皆为零，无需检查边界
+	constexpr ValueType element(SizeType _index) const noexcept
+	{
+		return apply(_left.element(_index), _right.element(_index));
+	}
+};
+
+// 取反表达式：结果元素数量与操作数一致，以外之元素仍为零
+template <typename _Operand>
+class BitComplement final : \
+	public BitExpressionBase<BitComplement<_Operand>, \
+		typename _Operand::ValueType>
+{
+public:
+	using ValueType = typename _Operand::ValueType;
+	using SizeType = std::size_t;
+
+private:
+	_Operand _operand;
+
+public:
+	constexpr explicit BitComplement(const _Operand& _operand) noexcept : \
+		_operand(_operand) {}
+
+	constexpr SizeType size() const noexcept
+	{
+		return _operand.size();
+	}
+
+	constexpr SizeType bound() const noexcept
+	{
+		return _operand.bound();
+	}
+
+	constexpr ValueType at(SizeType _index) const noexcept
+	{
+		return static_cast<ValueType>(~_operand.at(_index));
+	}
+
+	constexpr ValueType element(SizeType _index) const noexcept
+	{
+		return _index < size() ? \
+			static_cast<ValueType>(~_operand.element(_index)) : 0;
+	}
+};
+
+ETERFREE_SPACE_END
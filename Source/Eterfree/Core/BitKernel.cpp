@@ -0,0 +1,859 @@
+﻿#include "BitKernel.h"
+#include "Eterfree/Platform/Core/CPU.h"
+
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(PLATFORM_X86)
+#include <immintrin.h>
+#elif defined(PLATFORM_NEON)
+#include <arm_neon.h>
+#endif
+
+ETERFREE_SPACE_BEGIN
+
+using namespace Platform;
+
+using ByteType = std::uint8_t;
+using WordType = std::uint64_t;
+
+// 字之位数量
+constexpr std::size_t WORD_BITS = CHAR_BIT * sizeof(WordType);
+
+// 二元位运算
+struct And
+{
+	static WordType apply(WordType _left, WordType _right) noexcept
+	{
+		return _left & _right;
+	}
+};
+
+struct Or
+{
+	static WordType apply(WordType _left, WordType _right) noexcept
+	{
+		return _left | _right;
+	}
+};
+
+struct Xor
+{
+	static WordType apply(WordType _left, WordType _right) noexcept
+	{
+		return _left ^ _right;
+	}
+};
+
+static WordType load(const ByteType* _data) noexcept
+{
+	WordType word;
+	std::memcpy(&word, _data, sizeof word);
+	return word;
+}
+
+static void store(ByteType* _data, WordType _word) noexcept
+{
+	std::memcpy(_data, &_word, sizeof _word);
+}
+
+// 标量实现：按字处理，剩余字节逐个处理
+static std::size_t countScalar(const ByteType* _data, \
+	std::size_t _size) noexcept
+{
+	std::size_t counter = 0;
+
+	std::size_t index = 0;
+	for (; index + sizeof(WordType) <= _size; index += sizeof(WordType))
+		counter += std::popcount(load(_data + index));
+
+	for (; index < _size; ++index)
+		counter += std::popcount(_data[index]);
+	return counter;
+}
+
+static bool allScalar(const ByteType* _data, \
+	std::size_t _size, bool _value) noexcept
+{
+	auto byte = static_cast<ByteType>(_value ? ~0U : 0U);
+	auto word = static_cast<WordType>(_value ? ~0ULL : 0ULL);
+
+	std::size_t index = 0;
+	for (; index + sizeof(WordType) <= _size; index += sizeof(WordType))
+		if (load(_data + index) != word) return false;
+
+	for (; index < _size; ++index)
+		if (_data[index] != byte) return false;
+	return true;
+}
+
+template <typename _Operation>
+static void applyScalar(ByteType* _target, \
+	const ByteType* _source, std::size_t _size) noexcept
+{
+	std::size_t index = 0;
+	for (; index + sizeof(WordType) <= _size; index += sizeof(WordType))
+	{
+		auto word = _Operation::apply(load(_target + index), \
+			load(_source + index));
+		store(_target + index, word);
+	}
+
+	for (; index < _size; ++index)
+		_target[index] = static_cast<ByteType>(_Operation::apply( \
+			_target[index], _source[index]));
+}
+
+static void flipScalar(ByteType* _data, std::size_t _size) noexcept
+{
+	std::size_t index = 0;
+	for (; index + sizeof(WordType) <= _size; index += sizeof(WordType))
+		store(_data + index, ~load(_data + index));
+
+	for (; index < _size; ++index)
+		_data[index] = static_cast<ByteType>(~_data[index]);
+}
+
+// 读取_index起之字，范围以外之字节为零，按小端字节序拼接
+static WordType load(const ByteType* _data, \
+	std::size_t _size, std::ptrdiff_t _index) noexcept
+{
+	if (_index >= 0 \
+		and static_cast<std::size_t>(_index) + sizeof(WordType) <= _size)
+		return load(_data + _index);
+
+	WordType word = 0;
+	for (std::size_t offset = 0; offset < sizeof word; ++offset)
+	{
+		auto index = _index + static_cast<std::ptrdiff_t>(offset);
+		if (index >= 0 and static_cast<std::size_t>(index) < _size)
+			word |= static_cast<WordType>(_data[index]) << CHAR_BIT * offset;
+	}
+	return word;
+}
+
+// 右移一个字：结果字由源字及其高位字拼接，写入不超过_length字节
+static void rightShiftWord(ByteType* _target, std::size_t _length, \
+	const ByteType* _source, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _index) noexcept
+{
+	auto cursor = static_cast<std::ptrdiff_t>(_index + _offset);
+	auto low = load(_source, _size, cursor);
+	auto high = load(_source, _size, cursor + sizeof(WordType));
+	auto word = (low >> _shift) | (high << (WORD_BITS - _shift));
+	std::memcpy(_target + _index, &word, \
+		std::min(sizeof word, _length - _index));
+}
+
+// 左移一个字：结果字由源字及其低位字拼接，写入不超过_size字节
+static void leftShiftWord(ByteType* _data, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _index) noexcept
+{
+	auto cursor = static_cast<std::ptrdiff_t>(_index - _offset);
+	auto high = load(_data, _size, cursor);
+	auto low = load(_data, _size, cursor - sizeof(WordType));
+	auto word = (high << _shift) | (low >> (WORD_BITS - _shift));
+	std::memcpy(_data + _index, &word, \
+		std::min(sizeof word, _size - _index));
+}
+
+// 右移之标量实现：自_index字节起递增处理整字，结果可与源相同
+static void rightShiftScalar(ByteType* _target, std::size_t _length, \
+	const ByteType* _source, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _index = 0) noexcept
+{
+	for (; _index + sizeof(WordType) <= _length; _index += sizeof(WordType))
+		rightShiftWord(_target, _length, _source, _size, \
+			_offset, _shift, _index);
+}
+
+// 左移之标量实现：自_end字节以下递减处理整字，直至_offset
+static void leftShiftScalar(ByteType* _data, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _end) noexcept
+{
+	while (_end >= _offset + sizeof(WordType))
+	{
+		_end -= sizeof(WordType);
+		leftShiftWord(_data, _size, _offset, _shift, _end);
+	}
+}
+
+#if defined(PLATFORM_X86)
+PLATFORM_TARGET("popcnt")
+static std::size_t countPOPCNT(const ByteType* _data, \
+	std::size_t _size) noexcept
+{
+	// 四路累加，隐藏指令延迟
+	std::size_t counters[4] = {};
+
+	std::size_t index = 0;
+	constexpr auto BLOCK = sizeof(WordType) * 4;
+	for (; index + BLOCK <= _size; index += BLOCK)
+		for (std::size_t lane = 0; lane < 4; ++lane)
+			counters[lane] += std::popcount(load(_data + index \
+				+ lane * sizeof(WordType)));
+
+	auto counter = counters[0] + counters[1] + counters[2] + counters[3];
+	return counter + countScalar(_data + index, _size - index);
+}
+
+template <typename _Operation>
+static __m128i apply128(__m128i _left, __m128i _right) noexcept
+{
+	if constexpr (std::is_same_v<_Operation, And>)
+		return _mm_and_si128(_left, _right);
+	else if constexpr (std::is_same_v<_Operation, Or>)
+		return _mm_or_si128(_left, _right);
+	else
+		return _mm_xor_si128(_left, _right);
+}
+
+template <typename _Operation>
+PLATFORM_TARGET("avx2")
+static __m256i apply256(__m256i _left, __m256i _right) noexcept
+{
+	if constexpr (std::is_same_v<_Operation, And>)
+		return _mm256_and_si256(_left, _right);
+	else if constexpr (std::is_same_v<_Operation, Or>)
+		return _mm256_or_si256(_left, _right);
+	else
+		return _mm256_xor_si256(_left, _right);
+}
+
+static bool allSSE2(const ByteType* _data, \
+	std::size_t _size, bool _value) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m128i);
+
+	auto word = _mm_set1_epi8(static_cast<char>(_value ? ~0 : 0));
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 4 <= _size; index += BLOCK * 4)
+	{
+		auto data = reinterpret_cast<const __m128i*>(_data + index);
+		auto a = _mm_cmpeq_epi8(_mm_loadu_si128(data), word);
+		auto b = _mm_cmpeq_epi8(_mm_loadu_si128(data + 1), word);
+		auto c = _mm_cmpeq_epi8(_mm_loadu_si128(data + 2), word);
+		auto d = _mm_cmpeq_epi8(_mm_loadu_si128(data + 3), word);
+		auto mask = _mm_and_si128(_mm_and_si128(a, b), _mm_and_si128(c, d));
+		if (_mm_movemask_epi8(mask) != 0xFFFF) return false;
+	}
+	return allScalar(_data + index, _size - index, _value);
+}
+
+template <typename _Operation>
+static void applySSE2(ByteType* _target, \
+	const ByteType* _source, std::size_t _size) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m128i);
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 2 <= _size; index += BLOCK * 2)
+	{
+		auto target = reinterpret_cast<__m128i*>(_target + index);
+		auto source = reinterpret_cast<const __m128i*>(_source + index);
+		auto a = apply128<_Operation>(_mm_loadu_si128(target), \
+			_mm_loadu_si128(source));
+		auto b = apply128<_Operation>(_mm_loadu_si128(target + 1), \
+			_mm_loadu_si128(source + 1));
+		_mm_storeu_si128(target, a);
+		_mm_storeu_si128(target + 1, b);
+	}
+	applyScalar<_Operation>(_target + index, _source + index, _size - index);
+}
+
+static void flipSSE2(ByteType* _data, std::size_t _size) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m128i);
+
+	auto ones = _mm_set1_epi8(static_cast<char>(~0));
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 2 <= _size; index += BLOCK * 2)
+	{
+		auto data = reinterpret_cast<__m128i*>(_data + index);
+		auto a = _mm_xor_si128(_mm_loadu_si128(data), ones);
+		auto b = _mm_xor_si128(_mm_loadu_si128(data + 1), ones);
+		_mm_storeu_si128(data, a);
+		_mm_storeu_si128(data + 1, b);
+	}
+	flipScalar(_data + index, _size - index);
+}
+
+// 右移：每次处理两个字，源字及其高位字以非对齐读取
+static void rightShiftSSE2(ByteType* _target, std::size_t _length, \
+	const ByteType* _source, std::size_t _size, \
+	std::size_t _offset, unsigned _shift) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m128i);
+
+	auto right = _mm_cvtsi32_si128(static_cast<int>(_shift));
+	auto left = _mm_cvtsi32_si128(static_cast<int>(WORD_BITS - _shift));
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _length \
+		and index + _offset + BLOCK + sizeof(WordType) <= _size; \
+		index += BLOCK)
+	{
+		auto source = _source + index + _offset;
+		auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>( \
+			source + sizeof(WordType)));
+		auto value = _mm_or_si128(_mm_srl_epi64(low, right), \
+			_mm_sll_epi64(high, left));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_target + index), value);
+	}
+	rightShiftScalar(_target, _length, _source, _size, _offset, _shift, index);
+}
+
+// 左移：自高位递减，每次处理两个字
+static void leftShiftSSE2(ByteType* _data, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _end) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m128i);
+
+	auto left = _mm_cvtsi32_si128(static_cast<int>(_shift));
+	auto right = _mm_cvtsi32_si128(static_cast<int>(WORD_BITS - _shift));
+
+	// 源之低位字不早于首字节
+	while (_end >= _offset + BLOCK + sizeof(WordType))
+	{
+		_end -= BLOCK;
+		auto source = _data + _end - _offset;
+		auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>( \
+			source - sizeof(WordType)));
+		auto value = _mm_or_si128(_mm_sll_epi64(high, left), \
+			_mm_srl_epi64(low, right));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_data + _end), value);
+	}
+	leftShiftScalar(_data, _size, _offset, _shift, _end);
+}
+
+// 按半字节查表统计，结果为四个六十四位计数
+PLATFORM_TARGET("avx2")
+static __m256i count256(__m256i _value) noexcept
+{
+	const auto table = _mm256_setr_epi8( \
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, \
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const auto mask = _mm256_set1_epi8(0x0F);
+
+	auto low = _mm256_and_si256(_value, mask);
+	auto high = _mm256_and_si256(_mm256_srli_epi16(_value, 4), mask);
+	auto counter = _mm256_add_epi8(_mm256_shuffle_epi8(table, low), \
+		_mm256_shuffle_epi8(table, high));
+	return _mm256_sad_epu8(counter, _mm256_setzero_si256());
+}
+
+// 进位保存加法器
+PLATFORM_TARGET("avx2")
+static void add(__m256i& _high, __m256i& _low, \
+	__m256i _a, __m256i _b, __m256i _c) noexcept
+{
+	auto value = _mm256_xor_si256(_a, _b);
+	_high = _mm256_or_si256(_mm256_and_si256(_a, _b), \
+		_mm256_and_si256(value, _c));
+	_low = _mm256_xor_si256(value, _c);
+}
+
+// 累加相邻两个向量
+PLATFORM_TARGET("avx2")
+static void add(__m256i& _high, __m256i& _low, \
+	const __m256i* _data) noexcept
+{
+	add(_high, _low, _low, _mm256_loadu_si256(_data), \
+		_mm256_loadu_si256(_data + 1));
+}
+
+// Harley-Seal：每十六个向量仅统计一次
+PLATFORM_TARGET("avx2")
+static std::size_t countAVX2(const ByteType* _data, \
+	std::size_t _size) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	auto data = reinterpret_cast<const __m256i*>(_data);
+	auto size = _size / BLOCK;
+
+	auto total = _mm256_setzero_si256();
+	auto ones = _mm256_setzero_si256();
+	auto twos = _mm256_setzero_si256();
+	auto fours = _mm256_setzero_si256();
+	auto eights = _mm256_setzero_si256();
+	__m256i sixteens, twosA, twosB, foursA, foursB, eightsA, eightsB;
+
+	std::size_t index = 0;
+	for (; index + 16 <= size; index += 16)
+	{
+		add(twosA, ones, data + index);
+		add(twosB, ones, data + index + 2);
+		add(foursA, twos, twos, twosA, twosB);
+		add(twosA, ones, data + index + 4);
+		add(twosB, ones, data + index + 6);
+		add(foursB, twos, twos, twosA, twosB);
+		add(eightsA, fours, fours, foursA, foursB);
+		add(twosA, ones, data + index + 8);
+		add(twosB, ones, data + index + 10);
+		add(foursA, twos, twos, twosA, twosB);
+		add(twosA, ones, data + index + 12);
+		add(twosB, ones, data + index + 14);
+		add(foursB, twos, twos, twosA, twosB);
+		add(eightsB, fours, fours, foursA, foursB);
+		add(sixteens, eights, eights, eightsA, eightsB);
+		total = _mm256_add_epi64(total, count256(sixteens));
+	}
+
+	total = _mm256_slli_epi64(total, 4);
+	total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(eights), 3));
+	total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(fours), 2));
+	total = _mm256_add_epi64(total, _mm256_slli_epi64(count256(twos), 1));
+	total = _mm256_add_epi64(total, count256(ones));
+
+	for (; index < size; ++index)
+	{
+		auto value = _mm256_loadu_si256(data + index);
+		total = _mm256_add_epi64(total, count256(value));
+	}
+
+	alignas(BLOCK) std::uint64_t counters[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(counters), total);
+
+	auto counter = counters[0] + counters[1] + counters[2] + counters[3];
+	auto offset = size * BLOCK;
+	return static_cast<std::size_t>(counter) \
+		+ countScalar(_data + offset, _size - offset);
+}
+
+PLATFORM_TARGET("avx2")
+static bool allAVX2(const ByteType* _data, \
+	std::size_t _size, bool _value) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	auto word = _mm256_set1_epi8(static_cast<char>(_value ? ~0 : 0));
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 4 <= _size; index += BLOCK * 4)
+	{
+		auto data = reinterpret_cast<const __m256i*>(_data + index);
+		auto a = _mm256_xor_si256(_mm256_loadu_si256(data), word);
+		auto b = _mm256_xor_si256(_mm256_loadu_si256(data + 1), word);
+		auto c = _mm256_xor_si256(_mm256_loadu_si256(data + 2), word);
+		auto d = _mm256_xor_si256(_mm256_loadu_si256(data + 3), word);
+		auto mask = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if (not _mm256_testz_si256(mask, mask)) return false;
+	}
+	return allScalar(_data + index, _size - index, _value);
+}
+
+template <typename _Operation>
+PLATFORM_TARGET("avx2")
+static void applyAVX2(ByteType* _target, \
+	const ByteType* _source, std::size_t _size) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 4 <= _size; index += BLOCK * 4)
+	{
+		auto target = reinterpret_cast<__m256i*>(_target + index);
+		auto source = reinterpret_cast<const __m256i*>(_source + index);
+		for (std::size_t lane = 0; lane < 4; ++lane)
+		{
+			auto value = apply256<_Operation>(_mm256_loadu_si256(target + lane), \
+				_mm256_loadu_si256(source + lane));
+			_mm256_storeu_si256(target + lane, value);
+		}
+	}
+	applyScalar<_Operation>(_target + index, _source + index, _size - index);
+}
+
+PLATFORM_TARGET("avx2")
+static void flipAVX2(ByteType* _data, std::size_t _size) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	auto ones = _mm256_set1_epi8(static_cast<char>(~0));
+
+	std::size_t index = 0;
+	for (; index + BLOCK * 4 <= _size; index += BLOCK * 4)
+	{
+		auto data = reinterpret_cast<__m256i*>(_data + index);
+		for (std::size_t lane = 0; lane < 4; ++lane)
+		{
+			auto value = _mm256_xor_si256(_mm256_loadu_si256(data + lane), ones);
+			_mm256_storeu_si256(data + lane, value);
+		}
+	}
+	flipScalar(_data + index, _size - index);
+}
+
+// 右移：每次处理四个字
+PLATFORM_TARGET("avx2")
+static void rightShiftAVX2(ByteType* _target, std::size_t _length, \
+	const ByteType* _source, std::size_t _size, \
+	std::size_t _offset, unsigned _shift) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	auto right = _mm_cvtsi32_si128(static_cast<int>(_shift));
+	auto left = _mm_cvtsi32_si128(static_cast<int>(WORD_BITS - _shift));
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _length \
+		and index + _offset + BLOCK + sizeof(WordType) <= _size; \
+		index += BLOCK)
+	{
+		auto source = _source + index + _offset;
+		auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+		auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>( \
+			source + sizeof(WordType)));
+		auto value = _mm256_or_si256(_mm256_srl_epi64(low, right), \
+			_mm256_sll_epi64(high, left));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(_target + index), value);
+	}
+	rightShiftScalar(_target, _length, _source, _size, _offset, _shift, index);
+}
+
+// 左移：自高位递减，每次处理四个字
+PLATFORM_TARGET("avx2")
+static void leftShiftAVX2(ByteType* _data, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _end) noexcept
+{
+	constexpr auto BLOCK = sizeof(__m256i);
+
+	auto left = _mm_cvtsi32_si128(static_cast<int>(_shift));
+	auto right = _mm_cvtsi32_si128(static_cast<int>(WORD_BITS - _shift));
+
+	// 源之低位字不早于首字节
+	while (_end >= _offset + BLOCK + sizeof(WordType))
+	{
+		_end -= BLOCK;
+		auto source = _data + _end - _offset;
+		auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+		auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>( \
+			source - sizeof(WordType)));
+		auto value = _mm256_or_si256(_mm256_sll_epi64(high, left), \
+			_mm256_srl_epi64(low, right));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(_data + _end), value);
+	}
+	leftShiftScalar(_data, _size, _offset, _shift, _end);
+}
+
+#elif defined(PLATFORM_NEON)
+static std::size_t countNEON(const ByteType* _data, \
+	std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint8x16_t);
+
+	auto total = vdupq_n_u64(0);
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _size; index += BLOCK)
+	{
+		auto counter = vcntq_u8(vld1q_u8(_data + index));
+		total = vaddq_u64(total, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counter))));
+	}
+
+	auto counter = vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1);
+	return static_cast<std::size_t>(counter) \
+		+ countScalar(_data + index, _size - index);
+}
+
+static bool allNEON(const ByteType* _data, \
+	std::size_t _size, bool _value) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint8x16_t);
+
+	auto word = vdupq_n_u8(static_cast<ByteType>(_value ? ~0U : 0U));
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _size; index += BLOCK)
+	{
+		auto mask = veorq_u8(vld1q_u8(_data + index), word);
+		auto value = vreinterpretq_u64_u8(mask);
+		if ((vgetq_lane_u64(value, 0) | vgetq_lane_u64(value, 1)) != 0)
+			return false;
+	}
+	return allScalar(_data + index, _size - index, _value);
+}
+
+template <typename _Operation>
+static void applyNEON(ByteType* _target, \
+	const ByteType* _source, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint8x16_t);
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _size; index += BLOCK)
+	{
+		auto left = vld1q_u8(_target + index);
+		auto right = vld1q_u8(_source + index);
+		if constexpr (std::is_same_v<_Operation, And>)
+			left = vandq_u8(left, right);
+		else if constexpr (std::is_same_v<_Operation, Or>)
+			left = vorrq_u8(left, right);
+		else
+			left = veorq_u8(left, right);
+		vst1q_u8(_target + index, left);
+	}
+	applyScalar<_Operation>(_target + index, _source + index, _size - index);
+}
+
+static void flipNEON(ByteType* _data, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint8x16_t);
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _size; index += BLOCK)
+		vst1q_u8(_data + index, vmvnq_u8(vld1q_u8(_data + index)));
+	flipScalar(_data + index, _size - index);
+}
+
+// 右移：每次处理两个字，负位移计数表示右移
+static void rightShiftNEON(ByteType* _target, std::size_t _length, \
+	const ByteType* _source, std::size_t _size, \
+	std::size_t _offset, unsigned _shift) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint64x2_t);
+
+	auto right = vdupq_n_s64(-static_cast<std::int64_t>(_shift));
+	auto left = vdupq_n_s64(static_cast<std::int64_t>(WORD_BITS - _shift));
+
+	std::size_t index = 0;
+	for (; index + BLOCK <= _length \
+		and index + _offset + BLOCK + sizeof(WordType) <= _size; \
+		index += BLOCK)
+	{
+		auto source = _source + index + _offset;
+		auto low = vreinterpretq_u64_u8(vld1q_u8(source));
+		auto high = vreinterpretq_u64_u8(vld1q_u8(source + sizeof(WordType)));
+		auto value = vorrq_u64(vshlq_u64(low, right), vshlq_u64(high, left));
+		vst1q_u8(_target + index, vreinterpretq_u8_u64(value));
+	}
+	rightShiftScalar(_target, _length, _source, _size, _offset, _shift, index);
+}
+
+// 左移：自高位递减，每次处理两个字
+static void leftShiftNEON(ByteType* _data, std::size_t _size, \
+	std::size_t _offset, unsigned _shift, std::size_t _end) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint64x2_t);
+
+	auto left = vdupq_n_s64(static_cast<std::int64_t>(_shift));
+	auto right = vdupq_n_s64(-static_cast<std::int64_t>(WORD_BITS - _shift));
+
+	// 源之低位字不早于首字节
+	while (_end >= _offset + BLOCK + sizeof(WordType))
+	{
+		_end -= BLOCK;
+		auto source = _data + _end - _offset;
+		auto high = vreinterpretq_u64_u8(vld1q_u8(source));
+		auto low = vreinterpretq_u64_u8(vld1q_u8(source - sizeof(WordType)));
+		auto value = vorrq_u64(vshlq_u64(high, left), vshlq_u64(low, right));
+		vst1q_u8(_data + _end, vreinterpretq_u8_u64(value));
+	}
+	leftShiftScalar(_data, _size, _offset, _shift, _end);
+}
+#endif
+
+using CountKernel = std::size_t (*)(const ByteType*, std::size_t);
+using AllKernel = bool (*)(const ByteType*, std::size_t, bool);
+using ApplyKernel = void (*)(ByteType*, const ByteType*, std::size_t);
+using FlipKernel = void (*)(ByteType*, std::size_t);
+using RightShiftKernel = void (*)(ByteType*, std::size_t, \
+	const ByteType*, std::size_t, std::size_t, unsigned);
+using LeftShiftKernel = void (*)(ByteType*, std::size_t, \
+	std::size_t, unsigned, std::size_t);
+
+static CountKernel selectCount() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return countAVX2;
+	if (support(ISA_POPCNT)) return countPOPCNT;
+#elif defined(PLATFORM_NEON)
+	return countNEON;
+#endif
+	return countScalar;
+}
+
+static AllKernel selectAll() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return allAVX2;
+	return allSSE2;
+#elif defined(PLATFORM_NEON)
+	return allNEON;
+#else
+	return allScalar;
+#endif
+}
+
+template <typename _Operation>
+static ApplyKernel selectApply() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return applyAVX2<_Operation>;
+	return applySSE2<_Operation>;
+#elif defined(PLATFORM_NEON)
+	return applyNEON<_Operation>;
+#else
+	return applyScalar<_Operation>;
+#endif
+}
+
+static FlipKernel selectFlip() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return flipAVX2;
+	return flipSSE2;
+#elif defined(PLATFORM_NEON)
+	return flipNEON;
+#else
+	return flipScalar;
+#endif
+}
+
+static RightShiftKernel selectRightShift() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return rightShiftAVX2;
+	return rightShiftSSE2;
+#elif defined(PLATFORM_NEON)
+	return rightShiftNEON;
+#else
+	return [](ByteType* _target, std::size_t _length, \
+		const ByteType* _source, std::size_t _size, \
+		std::size_t _offset, unsigned _shift) noexcept
+	{
+		rightShiftScalar(_target, _length, _source, _size, _offset, _shift);
+	};
+#endif
+}
+
+static LeftShiftKernel selectLeftShift() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX2)) return leftShiftAVX2;
+	return leftShiftSSE2;
+#elif defined(PLATFORM_NEON)
+	return leftShiftNEON;
+#else
+	return leftShiftScalar;
+#endif
+}
+
+std::size_t countBit(const void* _data, std::size_t _size) noexcept
+{
+	static const auto kernel = selectCount();
+	return kernel(static_cast<const ByteType*>(_data), _size);
+}
+
+bool allBit(const void* _data, std::size_t _size, bool _value) noexcept
+{
+	static const auto kernel = selectAll();
+	return kernel(static_cast<const ByteType*>(_data), _size, _value);
+}
+
+void andBit(void* _target, const void* _source, std::size_t _size) noexcept
+{
+	static const auto kernel = selectApply<And>();
+	kernel(static_cast<ByteType*>(_target), \
+		static_cast<const ByteType*>(_source), _size);
+}
+
+void orBit(void* _target, const void* _source, std::size_t _size) noexcept
+{
+	static const auto kernel = selectApply<Or>();
+	kernel(static_cast<ByteType*>(_target), \
+		static_cast<const ByteType*>(_source), _size);
+}
+
+void xorBit(void* _target, const void* _source, std::size_t _size) noexcept
+{
+	static const auto kernel = selectApply<Xor>();
+	kernel(static_cast<ByteType*>(_target), \
+		static_cast<const ByteType*>(_source), _size);
+}
+
+void flipBit(void* _data, std::size_t _size) noexcept
+{
+	static const auto kernel = selectFlip();
+	kernel(static_cast<ByteType*>(_data), _size);
+}
+
+void leftShiftBit(void* _data, std::size_t _size, \
+	std::size_t _position) noexcept
+{
+	static const auto kernel = selectLeftShift();
+
+	auto data = static_cast<ByteType*>(_data);
+	if (_position >= CHAR_BIT * _size)
+	{
+		std::memset(data, 0, _size);
+		return;
+	}
+
+	// 整字节位移
+	if (_position % CHAR_BIT == 0)
+	{
+		auto offset = _position / CHAR_BIT;
+		std::memmove(data + offset, data, _size - offset);
+		std::memset(data, 0, offset);
+		return;
+	}
+
+	auto offset = _position / WORD_BITS * sizeof(WordType);
+	auto shift = static_cast<unsigned>(_position % WORD_BITS);
+
+	// 自高位递减处理：先处理末尾不足一字之字节，再处理整字
+	auto end = _size / sizeof(WordType) * sizeof(WordType);
+	if (end < _size and end >= offset)
+		leftShiftWord(data, _size, offset, shift, end);
+
+	kernel(data, _size, offset, shift, end);
+	std::memset(data, 0, std::min(offset, _size));
+}
+
+void rightShiftBit(void* _target, std::size_t _length, \
+	const void* _source, std::size_t _size, \
+	std::size_t _position) noexcept
+{
+	static const auto kernel = selectRightShift();
+
+	auto target = static_cast<ByteType*>(_target);
+	auto source = static_cast<const ByteType*>(_source);
+
+	// 整字节位移
+	if (_position % CHAR_BIT == 0)
+	{
+		auto offset = _position / CHAR_BIT;
+		auto size = offset < _size ? std::min(_length, _size - offset) : 0;
+		std::memmove(target, source + offset, size);
+		std::memset(target + size, 0, _length - size);
+		return;
+	}
+
+	auto offset = _position / WORD_BITS * sizeof(WordType);
+	auto shift = static_cast<unsigned>(_position % WORD_BITS);
+
+	// 源以外之结果为零
+	auto length = offset < _size ? std::min(_length, \
+		(_size - offset + sizeof(WordType) - 1) \
+		/ sizeof(WordType) * sizeof(WordType)) : 0;
+
+	auto end = length / sizeof(WordType) * sizeof(WordType);
+	kernel(target, end, source, _size, offset, shift);
+	if (end < length)
+		rightShiftWord(target, length, source, _size, offset, shift, end);
+
+	std::memset(target + length, 0, _length - length);
+}
+
+ETERFREE_SPACE_END
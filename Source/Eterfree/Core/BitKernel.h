@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include <cstddef>
+
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 位集合之批量核心函数：按字节处理，与元素类型无关，_size为字节数。
+ * 首次调用时依处理器特性选择AVX2、SSE2或NEON实现。
+ */
+
+// 统计有效位，大块数据采用Harley-Seal算法
+std::size_t countBit(const void* _data, std::size_t _size) noexcept;
+
+// 所有字节全零或全一
+bool allBit(const void* _data, std::size_t _size, bool _value) noexcept;
+
+void andBit(void* _target, const void* _source, std::size_t _size) noexcept;
+
+void orBit(void* _target, const void* _source, std::size_t _size) noexcept;
+
+void xorBit(void* _target, const void* _source, std::size_t _size) noexcept;
+
+void flipBit(void* _data, std::size_t _size) noexcept;
+
+/*
+ * 位移：视_size个字节为小端整数，仅适用于小端主机。
+ * 整字节位移退化为memmove，否则以64位字拼接相邻字。
+ */
+
+// 原地左移_position位，低位补零
+void leftShiftBit(void* _data, std::size_t _size, \
+	std::size_t _position) noexcept;
+
+// 源右移_position位之低_length字节写入目标，源以外之位为零，目标可与源相同
+void rightShiftBit(void* _target, std::size_t _length, \
+	const void* _source, std::size_t _size, \
+	std::size_t _position) noexcept;
+
+ETERFREE_SPACE_END
@@ -0,0 +1,46 @@
+﻿#include "BitParallel.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+ETERFREE_SPACE_BEGIN
+
+BitParallel::BitParallel(SizeType _threads, \
+	SizeType _grain) noexcept : _threads(_threads), _grain(_grain)
+{
+	if (_threads <= 0)
+		this->_threads = std::thread::hardware_concurrency();
+
+	if (this->_threads <= 0) this->_threads = 1;
+
+	if (_grain < ALIGNMENT) this->_grain = ALIGNMENT;
+}
+
+// 划分元素：分区元素数量按缓存行对齐，末分区可较小
+void BitParallel::execute(SizeType _size, SizeType _width, \
+	const Functor& _functor) const
+{
+	if (_size <= 0) return;
+
+	auto partitions = this->partitions(_size * _width);
+	if (partitions <= 1)
+	{
+		_functor(0, _size);
+		return;
+	}
+
+	auto alignment = std::max<SizeType>(ALIGNMENT / _width, 1);
+	auto length = (_size + partitions - 1) / partitions;
+	length = (length + alignment - 1) / alignment * alignment;
+
+	// 析构时等待线程结束，包括抛出异常时
+	std::vector<std::jthread> threads;
+	threads.reserve(partitions - 1);
+	for (auto begin = length; begin < _size; begin += length)
+		threads.emplace_back(_functor, begin, std::min(begin + length, _size));
+
+	_functor(0, std::min(length, _size));
+}
+
+ETERFREE_SPACE_END
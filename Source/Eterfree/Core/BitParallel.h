@@ -0,0 +1,280 @@
+﻿#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 位集合之并行批量操作：将元素向量按缓存行对齐划分为若干分区，
+ * 调用线程处理首个分区，其余分区各由一个线程处理，返回前等待所有分区完成。
+ * 每个分区至少_grain字节，较小之位集合退化为串行处理。
+ * 移位与复制异地生成结果，每个结果元素仅依赖两个源元素，分区之间无需传递进位。
+ */
+class BitParallel final
+{
+public:
+	using SizeType = std::size_t;
+
+	// 处理元素范围[_begin, _end)
+	using Functor = std::function<void(SizeType, SizeType)>;
+
+	// 分区之默认最小字节数
+	static constexpr SizeType DEFAULT_GRAIN = 1 << 20;
+
+	// 分区边界之对齐字节数
+	static constexpr SizeType ALIGNMENT = 64;
+
+private:
+	SizeType _threads; // 线程数量
+	SizeType _grain; // 分区最小字节数
+
+private:
+	// _bytes字节之分区数量
+	SizeType partitions(SizeType _bytes) const noexcept
+	{
+		return std::min(_threads, (_bytes + _grain - 1) / _grain);
+	}
+
+	// 划分_size个宽度为_width字节之元素
+	void execute(SizeType _size, SizeType _width, \
+		const Functor& _functor) const;
+
+public:
+	// 线程数量为零则取处理器核心数量
+	explicit BitParallel(SizeType _threads = 0, \
+		SizeType _grain = DEFAULT_GRAIN) noexcept;
+
+	auto threads() const noexcept
+	{
+		return _threads;
+	}
+
+	auto grain() const noexcept
+	{
+		return _grain;
+	}
+
+	// 统计有效位
+	template <std::unsigned_integral _ValueType>
+	SizeType count(const BitSet<_ValueType>& _bitSet) const;
+
+	// 统计表达式之有效位，不生成结果
+	template <BitExpressionType _Expression>
+	SizeType count(const _Expression& _expression) const;
+
+	/*
+	 * 表达式求值至_bitSet，_bitSet可为操作数，复合赋值形如assign(a, a & b)。
+	 * 无需扩容则就地求值。
+	 */
+	template <std::unsigned_integral _ValueType, BitExpressionType _Expression> \
+		requires std::same_as<typename _Expression::ValueType, _ValueType>
+	BitSet<_ValueType>& assign(BitSet<_ValueType>& _bitSet, \
+		const _Expression& _expression) const;
+
+	// 等价于_bitSet <<= _position
+	template <std::unsigned_integral _ValueType>
+	BitSet<_ValueType>& shiftLeft(BitSet<_ValueType>& _bitSet, \
+		SizeType _position) const;
+
+	// 等价于_bitSet >>= _position
+	template <std::unsigned_integral _ValueType>
+	BitSet<_ValueType>& shiftRight(BitSet<_ValueType>& _bitSet, \
+		SizeType _position) const;
+
+	// 等价于_bitSet.copy(_begin, _end)
+	template <std::unsigned_integral _ValueType>
+	BitSet<_ValueType> copy(const BitSet<_ValueType>& _bitSet, \
+		SizeType _begin, SizeType _end) const;
+};
+
+// 统计有效位
+template <std::unsigned_integral _ValueType>
+auto BitParallel::count(const BitSet<_ValueType>& _bitSet) const \
+-> SizeType
+{
+	std::atomic<SizeType> counter = 0;
+	execute(_bitSet.size(), sizeof(_ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			auto data = _bitSet.data() + _begin;
+			auto size = sizeof *data * (_end - _begin);
+			counter.fetch_add(countBit(data, size), \
+				std::memory_order::relaxed);
+		});
+	return counter.load(std::memory_order::relaxed);
+}
+
+// 统计表达式之有效位
+template <BitExpressionType _Expression>
+auto BitParallel::count(const _Expression& _expression) const \
+-> SizeType
+{
+	std::atomic<SizeType> counter = 0;
+	execute(_expression.size(), sizeof(typename _Expression::ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			counter.fetch_add(_expression.count(_begin, _end), \
+				std::memory_order::relaxed);
+		});
+	return counter.load(std::memory_order::relaxed);
+}
+
+// 表达式求值
+template <std::unsigned_integral _ValueType, BitExpressionType _Expression> \
+	requires std::same_as<typename _Expression::ValueType, _ValueType>
+auto BitParallel::assign(BitSet<_ValueType>& _bitSet, \
+	const _Expression& _expression) const -> BitSet<_ValueType>&
+{
+	auto size = _expression.size();
+	if (partitions(sizeof(_ValueType) * size) <= 1)
+		return _bitSet = _expression;
+
+	// 扩容则异地求值，避免操作数失效
+	if (size > _bitSet.size())
+	{
+		BitSet<_ValueType> bitSet(size);
+		return _bitSet = std::move(assign(bitSet, _expression));
+	}
+
+	execute(size, sizeof(_ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			_expression.evaluate(_bitSet.data() + _begin, _begin, _end);
+		});
+	return _bitSet.resize(size, true);
+}
+
+// 左移：结果元素由源元素及其低位元素拼接
+template <std::unsigned_integral _ValueType>
+auto BitParallel::shiftLeft(BitSet<_ValueType>& _bitSet, \
+	SizeType _position) const -> BitSet<_ValueType>&
+{
+	constexpr SizeType BITS = CHAR_BIT * sizeof(_ValueType);
+
+	if (_position <= 0) return _bitSet;
+
+	auto size = _bitSet.size();
+
+	// 单分区则就地移位，无需异地生成结果
+	if (partitions(sizeof(_ValueType) * size) <= 1)
+		return _bitSet <<= _position;
+
+	auto offset = _position / BITS;
+	auto shift = _position % BITS;
+	BitSet<_ValueType> bitSet(size);
+	execute(size, sizeof(_ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			auto source = _bitSet.data();
+			auto target = bitSet.data();
+			for (auto index = std::max(_begin, offset); index < _end; ++index)
+			{
+				auto cursor = index - offset;
+				auto element = static_cast<_ValueType>(source[cursor] << shift);
+
+				// 第一条件：避免未定义行为之位移计数过大
+				if (shift > 0 and cursor > 0)
+					element |= static_cast<_ValueType>(source[cursor - 1] \
+						>> (BITS - shift));
+				target[index] = element;
+			}
+		});
+	return _bitSet = std::move(bitSet);
+}
+
+// 右移：结果元素由源元素及其高位元素拼接
+template <std::unsigned_integral _ValueType>
+auto BitParallel::shiftRight(BitSet<_ValueType>& _bitSet, \
+	SizeType _position) const -> BitSet<_ValueType>&
+{
+	constexpr SizeType BITS = CHAR_BIT * sizeof(_ValueType);
+
+	if (_position <= 0) return _bitSet;
+
+	auto size = _bitSet.size();
+
+	// 单分区则就地移位，无需异地生成结果
+	if (partitions(sizeof(_ValueType) * size) <= 1)
+		return _bitSet >>= _position;
+
+	auto offset = _position / BITS;
+	auto shift = _position % BITS;
+	auto limit = offset < size ? size - offset : 0;
+
+	BitSet<_ValueType> bitSet(size);
+	execute(limit, sizeof(_ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			auto source = _bitSet.data();
+			auto target = bitSet.data();
+			for (auto index = _begin; index < _end; ++index)
+			{
+				auto cursor = index + offset;
+				auto element = static_cast<_ValueType>(source[cursor] >> shift);
+
+				// 第一条件：避免未定义行为之位移计数过大
+				if (shift > 0 and ++cursor < size)
+					element |= static_cast<_ValueType>(source[cursor] \
+						<< (BITS - shift));
+				target[index] = element;
+			}
+		});
+	return _bitSet = std::move(bitSet);
+}
+
+// 复制指定范围，语义与BitSet::copy一致
+template <std::unsigned_integral _ValueType>
+auto BitParallel::copy(const BitSet<_ValueType>& _bitSet, \
+	SizeType _begin, SizeType _end) const -> BitSet<_ValueType>
+{
+	constexpr SizeType BITS = CHAR_BIT * sizeof(_ValueType);
+
+	auto size = _bitSet.size();
+	if (_begin >= _end or _begin / BITS >= size)
+		return BitSet<_ValueType>();
+
+	_end = (_end - 1) / BITS < size ? _end : BITS * size;
+	auto difference = _end - _begin - 1;
+
+	auto offset = _begin / BITS;
+	auto shift = _begin % BITS;
+
+	BitSet<_ValueType> bitSet(difference / BITS + 1);
+	execute(bitSet.size(), sizeof(_ValueType), \
+		[&](SizeType _begin, SizeType _end)
+		{
+			auto source = _bitSet.data();
+			auto target = bitSet.data();
+			for (auto index = _begin; index < _end; ++index)
+			{
+				auto cursor = index + offset;
+				auto element = static_cast<_ValueType>(source[cursor] >> shift);
+
+				// 第一条件：避免未定义行为之位移计数过大
+				if (shift > 0 and ++cursor < size)
+					element |= static_cast<_ValueType>(source[cursor] \
+						<< (BITS - shift));
+				target[index] = element;
+			}
+		});
+
+	// 清除末元素超出范围之位
+	constexpr auto MAX_ELEMENT = static_cast<_ValueType>(~0ULL);
+	auto mask = static_cast<_ValueType>(MAX_ELEMENT \
+		>> (BITS - 1 - difference % BITS));
+
+	auto data = bitSet.data();
+	data[bitSet.size() - 1] &= mask;
+	return bitSet;
+}
+
+ETERFREE_SPACE_END
@@ -1,14 +1,19 @@
 ﻿#pragma once
 
+#include <bit>
 #include <concepts>
 #include <cstddef>
-#include <functional>
+#include <iterator>
+#include <cstdint>
 #include <climits>
 #include <cstring>
-#include <vector>
 #include <algorithm>
-#include <cmath>
+#include <type_traits>
+#include <utility>
 
+#include "BitExpression.hpp"
+#include "BitKernel.h"
+#include "SmallVector.hpp"
 #include "Common.hpp"
 
 ETERFREE_SPACE_BEGIN
@@ -55,17 +60,205 @@ void setBit(_BitSet& _bitSet, bool _value = true) noexcept
 	else _bitSet = ~static_cast<_BitSet>(0);
 }
 
+// 取反元素，以便零位查找复用有效位查找
+template <std::unsigned_integral _ValueType>
+constexpr _ValueType invertBit(_ValueType _element, bool _value) noexcept
+{
+	return _value ? _element : static_cast<_ValueType>(~_element);
+}
+
+/*
+ * 于_size个元素中查找位置不小于_position之首个指定值位，
+ * 逐元素跳过不含指定值之元素，未找到则返回元素之位数量。
+ */
+template <std::unsigned_integral _ValueType>
+constexpr std::size_t findBit(const _ValueType* _data, std::size_t _size, \
+	std::size_t _position, bool _value) noexcept
+{
+	constexpr std::size_t BITS = CHAR_BIT * sizeof(_ValueType);
+	constexpr auto MAX_ELEMENT = static_cast<_ValueType>(~0ULL);
+
+	auto index = _position / BITS;
+	if (index >= _size) return _size * BITS;
+
+	auto mask = static_cast<_ValueType>(MAX_ELEMENT << _position % BITS);
+	auto element = static_cast<_ValueType>(invertBit(_data[index], _value) & mask);
+	while (element == 0)
+	{
+		if (++index >= _size) return _size * BITS;
+
+		element = invertBit(_data[index], _value);
+	}
+	return index * BITS + std::countr_zero(element);
+}
+
+// 查找位置不大于_position之末个指定值位，_position须位于元素范围，未找到则返回全一
+template <std::unsigned_integral _ValueType>
+constexpr std::size_t rfindBit(const _ValueType* _data, \
+	std::size_t _position, bool _value) noexcept
+{
+	constexpr std::size_t BITS = CHAR_BIT * sizeof(_ValueType);
+	constexpr auto MAX_ELEMENT = static_cast<_ValueType>(~0ULL);
+
+	auto index = _position / BITS;
+	auto mask = static_cast<_ValueType>(MAX_ELEMENT \
+		>> (BITS - 1 - _position % BITS));
+	auto element = static_cast<_ValueType>(invertBit(_data[index], _value) & mask);
+	while (element == 0)
+	{
+		if (index <= 0) return ~static_cast<std::size_t>(0);
+
+		element = invertBit(_data[--index], _value);
+	}
+	return index * BITS + BITS - 1 - std::countl_zero(element);
+}
+
+// 范围操作类型
+enum BIT_OPERATION_TYPE : std::uint8_t
+{
+	BIT_OPERATION_SET,
+	BIT_OPERATION_RESET,
+	BIT_OPERATION_FLIP
+};
+
+/*
+ * 对_size个元素之位范围[_begin, _end)执行操作，超出元素之位忽略。
+ * 首尾元素按掩码处理，中间元素批量填充或翻转。
+ */
+template <BIT_OPERATION_TYPE _OPERATION, std::unsigned_integral _ValueType>
+void traverseBit(_ValueType* _data, std::size_t _size, \
+	std::size_t _begin, std::size_t _end) noexcept
+{
+	constexpr std::size_t BITS = CHAR_BIT * sizeof(_ValueType);
+	constexpr auto MAX_ELEMENT = static_cast<_ValueType>(~0ULL);
+
+	auto apply = [](_ValueType& _element, _ValueType _mask) noexcept
+	{
+		if constexpr (_OPERATION == BIT_OPERATION_SET)
+			_element |= _mask;
+		else if constexpr (_OPERATION == BIT_OPERATION_RESET)
+			_element &= static_cast<_ValueType>(~_mask);
+		else
+			_element ^= _mask;
+	};
+
+	if (_begin >= _end) return;
+
+	auto begin = _begin / BITS;
+	if (begin >= _size) return;
+
+	auto beginMask = static_cast<_ValueType>(MAX_ELEMENT << _begin % BITS);
+	auto endMask = static_cast<_ValueType>(MAX_ELEMENT \
+		>> (BITS - 1 - (_end - 1) % BITS));
+
+	// 末元素超出范围则截断
+	auto end = (_end - 1) / BITS;
+	if (end >= _size)
+	{
+		end = _size - 1;
+		endMask = MAX_ELEMENT;
+	}
+
+	if (begin == end)
+	{
+		apply(_data[begin], beginMask & endMask);
+		return;
+	}
+
+	apply(_data[begin], beginMask);
+	apply(_data[end], endMask);
+
+	auto data = _data + begin + 1;
+	auto length = sizeof *data * (end - begin - 1);
+	if constexpr (_OPERATION == BIT_OPERATION_SET)
+		std::memset(data, 0xFF, length);
+	else if constexpr (_OPERATION == BIT_OPERATION_RESET)
+		std::memset(data, 0, length);
+	else
+		flipBit(data, length);
+}
+
+// 有效位迭代器：解引用为位置，逐元素跳过零元素
+template <std::unsigned_integral _ValueType>
+class BitIterator final
+{
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+	using value_type = std::size_t;
+	using pointer = void;
+	using reference = std::size_t;
+
+private:
+	const _ValueType* _data;
+	std::size_t _size; // 元素数量
+	std::size_t _index; // 元素索引
+	_ValueType _element; // 元素之剩余有效位
+
+private:
+	// 跳至首个非零元素
+	constexpr void skip() noexcept
+	{
+		while (_element == 0 and ++_index < _size)
+			_element = _data[_index];
+	}
+
+public:
+	constexpr BitIterator() noexcept : \
+		_data(nullptr), _size(0), _index(0), _element(0) {}
+
+	constexpr BitIterator(const _ValueType* _data, \
+		std::size_t _size, std::size_t _index) noexcept : \
+		_data(_data), _size(_size), _index(_index), \
+		_element(_index < _size ? _data[_index] : 0)
+	{
+		if (_index < _size) skip();
+	}
+
+	constexpr bool operator==(const BitIterator& _iterator) const noexcept
+	{
+		return _index == _iterator._index \
+			and _element == _iterator._element;
+	}
+
+	constexpr std::size_t operator*() const noexcept
+	{
+		return _index * CHAR_BIT * sizeof(_ValueType) \
+			+ std::countr_zero(_element);
+	}
+
+	constexpr BitIterator& operator++() noexcept
+	{
+		// 清除最低有效位
+		_element &= static_cast<_ValueType>(_element - 1);
+		skip();
+		return *this;
+	}
+
+	constexpr BitIterator operator++(int) noexcept
+	{
+		auto iterator = *this;
+		++*this;
+		return iterator;
+	}
+};
+
 template <std::unsigned_integral _ValueType>
 class BitSet final
 {
-	using Vector = std::vector<_ValueType>;
-	using Functor = \
-		std::function<void(_ValueType&, _ValueType)>;
+	// 内部缓冲与堆指针及容量等长，一百二十八位以内无需分配堆内存
+	using Vector = SmallVector<_ValueType, \
+		sizeof(void*) * 2 / sizeof(_ValueType)>;
 
 public:
 	using ValueType = _ValueType;
 	using SizeType = Vector::size_type;
 
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	using Iterator = BitIterator<ValueType>;
+
 private:
 	// 单元素最大值
 	static constexpr ValueType MAX_ELEMENT = \
@@ -76,30 +269,12 @@ private:
 		CHAR_BIT * sizeof(ValueType) - 1;
 
 	// 单元素之位数量对数
-	static const SizeType BIT_SIZE_LOG2;
+	static constexpr SizeType BIT_SIZE_LOG2 = \
+		std::countr_zero(CHAR_BIT * sizeof(ValueType));
 
 private:
 	Vector _vector; // 元素向量
 
-public:
-	friend auto operator&(const BitSet& _left, \
-		const BitSet& _right)
-	{
-		return BitSet(_left) &= _right;
-	}
-
-	friend auto operator|(const BitSet& _left, \
-		const BitSet& _right)
-	{
-		return BitSet(_left) |= _right;
-	}
-
-	friend auto operator^(const BitSet& _left, \
-		const BitSet& _right)
-	{
-		return BitSet(_left) ^= _right;
-	}
-
 private:
 	// 位容量
 	static constexpr auto capacity(SizeType _position) noexcept
@@ -114,7 +289,10 @@ private:
 	}
 
 	// 统计有效位
-	static constexpr SizeType count(ValueType _element) noexcept;
+	static constexpr SizeType count(ValueType _element) noexcept
+	{
+		return static_cast<SizeType>(std::popcount(_element));
+	}
 
 	// 生成单元素
 	static constexpr ValueType generate(SizeType _position) noexcept
@@ -127,12 +305,12 @@ private:
 	// 预留空间
 	void reserve(SizeType _position);
 
-	// 判断所有元素值
-	bool all(ValueType _element) const noexcept;
-
-	// 遍历指定范围元素
-	void traverse(SizeType _begin, SizeType _end, \
-		Functor _functor) noexcept;
+	// 所有位皆为指定值
+	bool all(bool _value) const noexcept
+	{
+		return allBit(_vector.data(), \
+			sizeof(ValueType) * _vector.size(), _value);
+	}
 
 public:
 	BitSet(SizeType _size = 0) : _vector(_size, 0)
@@ -144,6 +322,20 @@ public:
 	BitSet(const ValueType* _data, SizeType _size) : \
 		_vector(_data, _data + _size) {}
 
+	// 表达式一次融合求值
+	template <BitExpressionType _Expression> \
+		requires std::same_as<typename _Expression::ValueType, _ValueType>
+	BitSet(const _Expression& _expression) : \
+		_vector(_expression.size(), 0)
+	{
+		_expression.evaluate(_vector.data());
+	}
+
+	// 无需扩容则就地求值，自身可为操作数
+	template <BitExpressionType _Expression> \
+		requires std::same_as<typename _Expression::ValueType, _ValueType>
+	BitSet& operator=(const _Expression& _expression);
+
 	bool operator==(const BitSet& _bitSet) const noexcept;
 
 	// C++ 20 != 采用 == 推导
@@ -163,9 +355,22 @@ public:
 
 	BitSet& operator^=(const BitSet& _bitSet);
 
-	auto operator~() const
+	template <BitExpressionType _Expression>
+	BitSet& operator&=(const _Expression& _expression)
+	{
+		return *this = *this & _expression;
+	}
+
+	template <BitExpressionType _Expression>
+	BitSet& operator|=(const _Expression& _expression)
 	{
-		return BitSet(*this).flip();
+		return *this = *this | _expression;
+	}
+
+	template <BitExpressionType _Expression>
+	BitSet& operator^=(const _Expression& _expression)
+	{
+		return *this = *this ^ _expression;
 	}
 
 	BitSet& operator<<=(SizeType _position) noexcept;
@@ -185,7 +390,51 @@ public:
 	// 存在有效位
 	bool exist(SizeType _position) const noexcept;
 
+	// 查找位置不小于_position之首个指定值位，元素以外之位视为零
+	SizeType find(SizeType _position, bool _value = true) const noexcept;
+
+	// 查找位置不大于_position之末个指定值位，元素以外之位视为零
+	SizeType rfind(SizeType _position, bool _value = true) const noexcept;
+
+	SizeType first(bool _value = true) const noexcept
+	{
+		return find(0, _value);
+	}
+
+	// 零位查找限于元素范围
+	SizeType last(bool _value = true) const noexcept
+	{
+		auto size = _vector.size();
+		return size > 0 ? rfind((size << BIT_SIZE_LOG2) - 1, _value) : NPOS;
+	}
+
+	SizeType next(SizeType _position, bool _value = true) const noexcept
+	{
+		return _position < NPOS ? find(_position + 1, _value) : NPOS;
+	}
+
+	SizeType prev(SizeType _position, bool _value = true) const noexcept
+	{
+		return _position > 0 ? rfind(_position - 1, _value) : NPOS;
+	}
+
+	// 遍历有效位
+	Iterator begin() const noexcept
+	{
+		return Iterator(_vector.data(), _vector.size(), 0);
+	}
+
+	Iterator end() const noexcept
+	{
+		return Iterator(_vector.data(), _vector.size(), _vector.size());
+	}
+
 	// 获取元素内容
+	auto data() noexcept
+	{
+		return _vector.data();
+	}
+
 	auto data() const noexcept
 	{
 		return _vector.data();
@@ -206,19 +455,19 @@ public:
 	// 所有位有效
 	bool all() const noexcept
 	{
-		return all(MAX_ELEMENT);
+		return all(true);
 	}
 
 	// 任意位有效
 	bool any() const noexcept
 	{
-		return not all(0);
+		return not all(false);
 	}
 
 	// 无有效位
 	bool none() const noexcept
 	{
-		return all(0);
+		return all(false);
 	}
 
 	// 设置指定位
@@ -257,90 +506,134 @@ public:
 	// 翻转所有位
 	BitSet& flip() noexcept;
 
-	// 复制指定范围
+	// 复制指定范围，_end超出位集合则截断
 	BitSet copy(SizeType _begin, SizeType _end) const;
+
+	/*
+	 * 复制指定范围至调用者缓冲，不分配内存。缓冲至少容纳范围之位所需元素，
+	 * 位集合以外之位为零。返回写入的元素数量。
+	 */
+	SizeType copy(SizeType _begin, SizeType _end, \
+		ValueType* _data) const noexcept;
 };
 
+// 位集合与表达式之操作数
 template <std::unsigned_integral _ValueType>
-const typename BitSet<_ValueType>::SizeType BitSet<_ValueType>::BIT_SIZE_LOG2 = \
-	static_cast<SizeType>(std::log2(CHAR_BIT * sizeof(ValueType)));
+constexpr auto bitOperand(const BitSet<_ValueType>& _bitSet) noexcept
+{
+	return BitLeaf<_ValueType>(_bitSet.data(), _bitSet.size());
+}
 
-// 统计有效位
-template <std::unsigned_integral _ValueType>
-constexpr auto BitSet<_ValueType>::count(ValueType _element) noexcept -> SizeType
-{
-	constexpr unsigned char MAX_CHARACTER = ~static_cast<unsigned char>('\0');
-	const char* const BIT_TABLE = \
-		"\0\1\1\2\1\2\2\3\1\2\2\3\2\3\3\4"
-		"\1\2\2\3\2\3\3\4\2\3\3\4\3\4\4\5"
-		"\1\2\2\3\2\3\3\4\2\3\3\4\3\4\4\5"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\1\2\2\3\2\3\3\4\2\3\3\4\3\4\4\5"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\3\4\4\5\4\5\5\6\4\5\5\6\5\6\6\7"
-		"\1\2\2\3\2\3\3\4\2\3\3\4\3\4\4\5"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\3\4\4\5\4\5\5\6\4\5\5\6\5\6\6\7"
-		"\2\3\3\4\3\4\4\5\3\4\4\5\4\5\5\6"
-		"\3\4\4\5\4\5\5\6\4\5\5\6\5\6\6\7"
-		"\3\4\4\5\4\5\5\6\4\5\5\6\5\6\6\7"
-		"\4\5\5\6\5\6\6\7\5\6\6\7\6\7\7\x8";
-
-	SizeType counter = 0;
-	for (auto index = sizeof _element; index > 0; --index)
-	{
-		counter += BIT_TABLE[_element & MAX_CHARACTER];
-		_element >>= CHAR_BIT;
-	}
-	return counter;
+template <BitExpressionType _Expression>
+constexpr const auto& bitOperand(const _Expression& _expression) noexcept
+{
+	return _expression;
 }
 
-// 预留空间
-template <std::unsigned_integral _ValueType>
-void BitSet<_ValueType>::reserve(SizeType _position)
+template <typename _Type>
+concept BitOperand = requires(const _Type& _operand)
 {
-	if (auto size = BitSet::size(_position); \
-		size > _vector.size())
-		_vector.resize(size, 0);
+	bitOperand(_operand);
+};
+
+template <typename _Type>
+using BitOperandType = std::remove_cvref_t<decltype(bitOperand(std::declval<const _Type&>()))>;
+
+// 按位运算返回惰性表达式，赋值或构造位集合时一次求值
+template <BitOperand _Left, BitOperand _Right>
+constexpr auto operator&(const _Left& _left, const _Right& _right) noexcept
+{
+	return BitExpression<BIT_EXPRESSION_AND, BitOperandType<_Left>, \
+		BitOperandType<_Right>>(bitOperand(_left), bitOperand(_right));
 }
 
-// 判断所有元素值
-template <std::unsigned_integral _ValueType>
-bool BitSet<_ValueType>::all(ValueType _element) const noexcept
+template <BitOperand _Left, BitOperand _Right>
+constexpr auto operator|(const _Left& _left, const _Right& _right) noexcept
 {
-	for (auto element : _vector)
-		if (element != _element) return false;
-	return true;
+	return BitExpression<BIT_EXPRESSION_OR, BitOperandType<_Left>, \
+		BitOperandType<_Right>>(bitOperand(_left), bitOperand(_right));
 }
 
-// 遍历指定范围元素
-template <std::unsigned_integral _ValueType>
-void BitSet<_ValueType>::traverse(SizeType _begin, SizeType _end, \
-	Functor _functor) noexcept
+template <BitOperand _Left, BitOperand _Right>
+constexpr auto operator^(const _Left& _left, const _Right& _right) noexcept
 {
-	if (not _functor) return;
+	return BitExpression<BIT_EXPRESSION_XOR, BitOperandType<_Left>, \
+		BitOperandType<_Right>>(bitOperand(_left), bitOperand(_right));
+}
 
-	auto beginPosition = _begin & MAX_POSITION;
-	auto endPosition = _end & MAX_POSITION;
+template <BitOperand _Operand>
+constexpr auto operator~(const _Operand& _operand) noexcept
+{
+	return BitComplement<BitOperandType<_Operand>>(bitOperand(_operand));
+}
 
-	ValueType beginMask = MAX_ELEMENT << beginPosition;
-	ValueType endMask = ~(MAX_ELEMENT << endPosition);
+// 右值位集合：表达式仅引用其元素，语句结束即悬空
+template <typename _Type>
+concept BitTemporary = not std::is_reference_v<_Type> \
+	and requires { typename _Type::ValueType; } \
+	and std::same_as<std::remove_cv_t<_Type>, BitSet<typename _Type::ValueType>>;
+
+template <typename _Left, typename _Right>
+concept BitDangling = BitOperand<std::remove_cvref_t<_Left>> \
+	and BitOperand<std::remove_cvref_t<_Right>> \
+	and (BitTemporary<_Left> or BitTemporary<_Right>);
+
+// 禁止以右值位集合构造表达式，须先求值或延长其生命周期
+template <typename _Left, typename _Right> \
+	requires BitDangling<_Left, _Right>
+void operator&(_Left&& _left, _Right&& _right) = delete;
+
+template <typename _Left, typename _Right> \
+	requires BitDangling<_Left, _Right>
+void operator|(_Left&& _left, _Right&& _right) = delete;
+
+template <typename _Left, typename _Right> \
+	requires BitDangling<_Left, _Right>
+void operator^(_Left&& _left, _Right&& _right) = delete;
+
+template <typename _Operand> \
+	requires BitTemporary<_Operand>
+void operator~(_Operand&& _operand) = delete;
+
+// 表达式之移位须先求值
+template <BitExpressionType _Expression>
+auto operator<<(const _Expression& _expression, std::size_t _position)
+{
+	BitSet<typename _Expression::ValueType> bitSet(_expression);
+	bitSet <<= _position;
+	return bitSet;
+}
 
-	auto size = std::min(_vector.size(), BitSet::size(_end - 1));
-	_begin >>= BIT_SIZE_LOG2;
-	_end >>= BIT_SIZE_LOG2;
+template <BitExpressionType _Expression>
+auto operator>>(const _Expression& _expression, std::size_t _position)
+{
+	BitSet<typename _Expression::ValueType> bitSet(_expression);
+	bitSet >>= _position;
+	return bitSet;
+}
 
-	for (auto index = _begin; index < size; ++index)
-	{
-		auto mask = MAX_ELEMENT;
-		if (index == _begin) mask &= beginMask;
+template <std::unsigned_integral _ValueType>
+template <BitExpressionType _Expression> \
+	requires std::same_as<typename _Expression::ValueType, _ValueType>
+auto BitSet<_ValueType>::operator=(const _Expression& _expression) \
+-> BitSet&
+{
+	auto size = _expression.size();
+	if (size > _vector.size())
+		return *this = BitSet(_expression);
 
-		if (index == _end) mask &= endMask;
+	_expression.evaluate(_vector.data());
+	_vector.resize(size, 0);
+	return *this;
+}
 
-		_functor(_vector[index], mask);
-	}
+// 预留空间
+template <std::unsigned_integral _ValueType>
+void BitSet<_ValueType>::reserve(SizeType _position)
+{
+	if (auto size = BitSet::size(_position); \
+		size > _vector.size())
+		_vector.resize(size, 0);
 }
 
 template <std::unsigned_integral _ValueType>
@@ -360,9 +653,9 @@ bool BitSet<_ValueType>::operator==(const BitSet& _bitSet) const noexcept
 	auto right = _bitSet._vector.data();
 	if (std::memcmp(left, right, sizeof *left * size) != 0) return false;
 
-	for (auto index = size; index < bitSet->_vector.size(); ++index)
-		if (bitSet->_vector[index] != 0) return false;
-	return true;
+	auto data = bitSet->_vector.data() + size;
+	auto remain = bitSet->_vector.size() - size;
+	return allBit(data, sizeof *data * remain, false);
 }
 
 template <std::unsigned_integral _ValueType>
@@ -373,13 +666,12 @@ auto BitSet<_ValueType>::operator&=(const BitSet& _bitSet) -> BitSet&
 	auto size = std::max(this->_vector.size(), _bitSet._vector.size());
 	resize(size);
 
-	decltype(size) index = 0;
-	for (; index < _bitSet._vector.size(); ++index)
-		this->_vector[index] &= _bitSet._vector[index];
+	auto index = _bitSet._vector.size();
+	auto data = this->_vector.data();
+	andBit(data, _bitSet._vector.data(), sizeof *data * index);
 
 	if (index < size)
 	{
-		auto data = this->_vector.data();
 		std::memset(data + index, 0, sizeof *data * (size - index));
 	}
 	return *this;
@@ -393,9 +685,9 @@ auto BitSet<_ValueType>::operator|=(const BitSet& _bitSet) -> BitSet&
 	auto size = std::max(this->_vector.size(), _bitSet._vector.size());
 	resize(size);
 
-	for (decltype(size) index = 0; \
-		index < _bitSet._vector.size(); ++index)
-		this->_vector[index] |= _bitSet._vector[index];
+	auto data = this->_vector.data();
+	orBit(data, _bitSet._vector.data(), \
+		sizeof *data * _bitSet._vector.size());
 	return *this;
 }
 
@@ -413,9 +705,9 @@ auto BitSet<_ValueType>::operator^=(const BitSet& _bitSet) -> BitSet&
 	auto size = std::max(this->_vector.size(), _bitSet._vector.size());
 	resize(size);
 
-	for (decltype(size) index = 0; \
-		index < _bitSet._vector.size(); ++index)
-		this->_vector[index] ^= _bitSet._vector[index];
+	auto data = this->_vector.data();
+	xorBit(data, _bitSet._vector.data(), \
+		sizeof *data * _bitSet._vector.size());
 	return *this;
 }
 
@@ -425,35 +717,44 @@ auto BitSet<_ValueType>::operator<<=(SizeType _position) noexcept \
 {
 	if (_position <= 0) return *this;
 
-	constexpr auto CAPACITY = capacity(MAX_POSITION);
-
-	auto offset = _position >> BIT_SIZE_LOG2;
-	_position &= MAX_POSITION;
+	// 小端主机之元素序列即小端整数，整字节位移退化为memmove
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		auto data = _vector.data();
+		leftShiftBit(data, sizeof *data * _vector.size(), _position);
+	}
+	else
+	{
+		constexpr auto CAPACITY = capacity(MAX_POSITION);
 
-	ValueType lowMask = MAX_ELEMENT >> _position;
-	ValueType highMask = ~lowMask;
+		auto offset = _position >> BIT_SIZE_LOG2;
+		_position &= MAX_POSITION;
 
-	auto index = _vector.size();
-	for (; index > offset; --index)
-	{
-		auto cursor = index - 1;
-		auto& target = _vector[cursor];
-		cursor -= offset;
-		auto source = _vector[cursor];
-		target = (source & lowMask) << _position;
+		ValueType lowMask = MAX_ELEMENT >> _position;
+		ValueType highMask = ~lowMask;
 
-		// 第一条件：避免未定义行为之位移计数为负或过大
-		if (_position > 0 and cursor > 0)
+		auto index = _vector.size();
+		for (; index > offset; --index)
 		{
-			auto source = _vector[cursor - 1];
-			target |= (source & highMask) >> CAPACITY - _position;
+			auto cursor = index - 1;
+			auto& target = _vector[cursor];
+			cursor -= offset;
+			auto source = _vector[cursor];
+			target = (source & lowMask) << _position;
+
+			// 第一条件：避免未定义行为之位移计数为负或过大
+			if (_position > 0 and cursor > 0)
+			{
+				auto source = _vector[cursor - 1];
+				target |= (source & highMask) >> (CAPACITY - _position);
+			}
 		}
-	}
 
-	if (index > 0)
-	{
-		auto data = _vector.data();
-		std::memset(data, 0, sizeof *data * index);
+		if (index > 0)
+		{
+			auto data = _vector.data();
+			std::memset(data, 0, sizeof *data * index);
+		}
 	}
 	return *this;
 }
@@ -464,38 +765,76 @@ auto BitSet<_ValueType>::operator>>=(SizeType _position) noexcept \
 {
 	if (_position <= 0) return *this;
 
-	constexpr auto CAPACITY = capacity(MAX_POSITION);
-
-	auto offset = _position >> BIT_SIZE_LOG2;
-	_position &= MAX_POSITION;
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		auto data = _vector.data();
+		auto size = sizeof *data * _vector.size();
+		rightShiftBit(data, size, data, size, _position);
+	}
+	else
+	{
+		constexpr auto CAPACITY = capacity(MAX_POSITION);
 
-	ValueType highMask = MAX_ELEMENT << _position;
-	ValueType lowMask = ~highMask;
+		auto offset = _position >> BIT_SIZE_LOG2;
+		_position &= MAX_POSITION;
 
-	auto size = _vector.size();
-	decltype(size) limit = offset < size ? size - offset : 0;
-	decltype(limit) index = 0;
-	for (; index < limit; ++index)
-	{
-		auto& target = _vector[index];
-		auto cursor = index + offset;
-		auto source = _vector[cursor];
-		target = (source & highMask) >> _position;
+		ValueType highMask = MAX_ELEMENT << _position;
+		ValueType lowMask = ~highMask;
 
-		// 第一条件：避免未定义行为之位移计数为负或过大
-		if (_position > 0 and ++cursor < size)
+		auto size = _vector.size();
+		decltype(size) limit = offset < size ? size - offset : 0;
+		decltype(limit) index = 0;
+		for (; index < limit; ++index)
 		{
+			auto& target = _vector[index];
+			auto cursor = index + offset;
 			auto source = _vector[cursor];
-			target |= (source & lowMask) << CAPACITY - _position;
+			target = (source & highMask) >> _position;
+
+			// 第一条件：避免未定义行为之位移计数为负或过大
+			if (_position > 0 and ++cursor < size)
+			{
+				auto source = _vector[cursor];
+				target |= (source & lowMask) << (CAPACITY - _position);
+			}
+		}
+
+		if (index < size)
+		{
+			auto data = _vector.data();
+			std::memset(data + index, 0, sizeof *data * (size - index));
 		}
 	}
+	return *this;
+}
 
-	if (index < size)
+// 查找首个指定值位
+template <std::unsigned_integral _ValueType>
+auto BitSet<_ValueType>::find(SizeType _position, \
+	bool _value) const noexcept -> SizeType
+{
+	auto size = _vector.size() << BIT_SIZE_LOG2;
+	auto position = findBit(_vector.data(), _vector.size(), _position, _value);
+	if (position < size) return position;
+
+	// 零位查找越过末元素，返回首个元素以外之位
+	return _value ? NPOS : std::max(_position, size);
+}
+
+// 查找末个指定值位
+template <std::unsigned_integral _ValueType>
+auto BitSet<_ValueType>::rfind(SizeType _position, \
+	bool _value) const noexcept -> SizeType
+{
+	auto size = _vector.size();
+	if (BitSet::size(_position) > size)
 	{
-		auto data = _vector.data();
-		std::memset(data + index, 0, sizeof *data * (size - index));
+		if (not _value) return _position;
+		if (size <= 0) return NPOS;
+
+		_position = (size << BIT_SIZE_LOG2) - 1;
 	}
-	return *this;
+	return rfindBit(_vector.data(), _position, _value);
 }
 
 // 存在有效位
@@ -523,10 +862,8 @@ template <std::unsigned_integral _ValueType>
 auto BitSet<_ValueType>::count() const noexcept \
 -> SizeType
 {
-	SizeType counter = 0;
-	for (auto element : _vector)
-		counter += count(element);
-	return counter;
+	auto data = _vector.data();
+	return countBit(data, sizeof *data * _vector.size());
 }
 
 // 设置指定位
@@ -553,9 +890,8 @@ auto BitSet<_ValueType>::set(SizeType _begin, SizeType _end, \
 	{
 		reserve(_end - 1);
 
-		traverse(_begin, _end, \
-			[](ValueType& _element, ValueType _mask) noexcept
-			{ _element |= _mask; });
+		traverseBit<BIT_OPERATION_SET>(_vector.data(), \
+			_vector.size(), _begin, _end);
 	}
 	return *this;
 }
@@ -575,9 +911,8 @@ auto BitSet<_ValueType>::reset(SizeType _begin, SizeType _end) noexcept \
 -> BitSet&
 {
 	if (_begin < _end and size(_begin) <= _vector.size())
-		traverse(_begin, _end, \
-			[](ValueType& _element, ValueType _mask) noexcept
-			{ _element &= ~_mask; });
+		traverseBit<BIT_OPERATION_RESET>(_vector.data(), \
+			_vector.size(), _begin, _end);
 	return *this;
 }
 
@@ -600,9 +935,8 @@ auto BitSet<_ValueType>::flip(SizeType _begin, SizeType _end) \
 	{
 		reserve(_end - 1);
 
-		traverse(_begin, _end, \
-			[](ValueType& _element, ValueType _mask) noexcept
-			{ _element ^= _mask; });
+		traverseBit<BIT_OPERATION_FLIP>(_vector.data(), \
+			_vector.size(), _begin, _end);
 	}
 	return *this;
 }
@@ -612,8 +946,8 @@ template <std::unsigned_integral _ValueType>
 auto BitSet<_ValueType>::flip() noexcept \
 -> BitSet&
 {
-	for (auto& element : _vector)
-		element = ~element;
+	auto data = _vector.data();
+	flipBit(data, sizeof *data * _vector.size());
 	return *this;
 }
 
@@ -628,42 +962,66 @@ auto BitSet<_ValueType>::copy(SizeType _begin, SizeType _end) const \
 
 	constexpr auto CAPACITY = capacity(MAX_POSITION);
 
-	auto position = _begin & MAX_POSITION;
-
-	ValueType highMask = MAX_ELEMENT << position;
-	ValueType lowMask = ~highMask;
-
 	auto size = _vector.size();
 	_end = BitSet::size(_end - 1) <= size ? _end : CAPACITY * size;
-	auto difference = _end - _begin - 1;
 
-	size = BitSet::size(difference);
-	BitSet bitSet(size);
+	BitSet bitSet(BitSet::size(_end - _begin - 1));
+	copy(_begin, _end, bitSet._vector.data());
+	return bitSet;
+}
 
-	auto offset = _begin >> BIT_SIZE_LOG2;
-	for (decltype(size) index = 0; index < size; ++index)
+// 复制指定范围至缓冲
+template <std::unsigned_integral _ValueType>
+auto BitSet<_ValueType>::copy(SizeType _begin, SizeType _end, \
+	ValueType* _data) const noexcept -> SizeType
+{
+	if (_begin >= _end) return 0;
+
+	auto difference = _end - _begin - 1;
+	auto size = BitSet::size(difference);
+
+	if constexpr (std::endian::native == std::endian::little)
+		rightShiftBit(_data, sizeof *_data * size, _vector.data(), \
+			sizeof *_data * _vector.size(), _begin);
+	else
 	{
-		auto& target = bitSet._vector[index];
-		auto cursor = index + offset;
-		auto source = this->_vector[cursor];
-		target = (source & highMask) >> position;
+		constexpr auto CAPACITY = capacity(MAX_POSITION);
+
+		auto position = _begin & MAX_POSITION;
+
+		ValueType highMask = MAX_ELEMENT << position;
+		ValueType lowMask = ~highMask;
 
-		// 第一条件：避免未定义行为之位移计数为负或过大
-		if (position > 0 and ++cursor < this->_vector.size())
+		auto offset = _begin >> BIT_SIZE_LOG2;
+		for (decltype(size) index = 0; index < size; ++index)
 		{
-			auto source = this->_vector[cursor];
-			target |= (source & lowMask) << CAPACITY - position;
+			auto& target = _data[index];
+			auto cursor = index + offset;
+			if (cursor >= _vector.size())
+			{
+				target = 0;
+				continue;
+			}
+
+			auto source = _vector[cursor];
+			target = (source & highMask) >> position;
+
+			// 第一条件：避免未定义行为之位移计数为负或过大
+			if (position > 0 and ++cursor < _vector.size())
+			{
+				auto source = _vector[cursor];
+				target |= (source & lowMask) << (CAPACITY - position);
+			}
 		}
 	}
 
 	// 两种算法等价
 	//position = MAX_POSITION - (difference & MAX_POSITION);
-	position = MAX_POSITION ^ (difference & MAX_POSITION);
+	auto position = MAX_POSITION ^ (difference & MAX_POSITION);
 	auto mask = MAX_ELEMENT >> position;
 
-	auto& element = bitSet._vector.back();
-	element &= mask;
-	return bitSet;
+	_data[size - 1] &= mask;
+	return size;
 }
 
 ETERFREE_SPACE_END
@@ -0,0 +1,303 @@
+﻿#pragma once
+
+#include <span>
+#include <concepts>
+#include <cstddef>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "BitKernel.h"
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 位集合视图：不持有外部元素，不复制不分配，位数量固定为元素之位数量。
+ * 元素类型为常量则仅可读取，否则可设置、重置、翻转与按位运算，超出元素之位忽略。
+ * 视图之生命周期不超过元素。
+ */
+template <typename _ElementType> \
+	requires std::unsigned_integral<std::remove_const_t<_ElementType>>
+class BitSetView final
+{
+	template <typename _Other> \
+		requires std::unsigned_integral<std::remove_const_t<_Other>>
+	friend class BitSetView;
+
+public:
+	using ElementType = _ElementType;
+	using ValueType = std::remove_const_t<ElementType>;
+	using SizeType = std::size_t;
+
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+	using Iterator = BitIterator<ValueType>;
+
+	// 只读视图
+	using ConstView = BitSetView<const ValueType>;
+
+private:
+	// 可修改元素
+	static constexpr bool MUTABLE = not std::is_const_v<ElementType>;
+
+private:
+	ElementType* _data;
+	SizeType _size; // 元素数量
+
+private:
+	static constexpr ValueType generate(SizeType _position) noexcept
+	{
+		return static_cast<ValueType>(1) << _position % BIT_SIZE;
+	}
+
+public:
+	constexpr BitSetView() noexcept : \
+		_data(nullptr), _size(0) {}
+
+	constexpr BitSetView(ElementType* _data, SizeType _size) noexcept : \
+		_data(_data), _size(_size) {}
+
+	template <std::size_t _Extent>
+	constexpr BitSetView(std::span<ElementType, _Extent> _span) noexcept : \
+		_data(_span.data()), _size(_span.size()) {}
+
+	BitSetView(BitSet<ValueType>& _bitSet) noexcept : \
+		_data(_bitSet.data()), _size(_bitSet.size()) {}
+
+	BitSetView(const BitSet<ValueType>& _bitSet) noexcept \
+		requires (not MUTABLE) : \
+		_data(_bitSet.data()), _size(_bitSet.size()) {}
+
+	// 可修改视图转换为只读视图，模板不抑制隐式复制构造函数
+	template <std::same_as<ValueType> _Other> requires (not MUTABLE)
+	constexpr BitSetView(const BitSetView<_Other>& _view) noexcept : \
+		_data(_view._data), _size(_view._size) {}
+
+	// 内容相等，较长者之多余元素须为零
+	bool operator==(ConstView _view) const noexcept
+	{
+		auto size = std::min(_size, _view._size);
+		if (std::memcmp(_data, _view._data, sizeof(ValueType) * size) != 0)
+			return false;
+
+		auto view = _size > size ? ConstView(*this) : _view;
+		return allBit(view._data + size, \
+			sizeof(ValueType) * (view._size - size), false);
+	}
+
+	bool operator[](SizeType _position) const noexcept
+	{
+		return exist(_position);
+	}
+
+	// 按位运算仅作用于公共元素，与运算清零多余元素
+	BitSetView& operator&=(ConstView _view) noexcept requires MUTABLE
+	{
+		auto size = std::min(_size, _view._size);
+		andBit(_data, _view._data, sizeof(ValueType) * size);
+		std::memset(_data + size, 0, sizeof(ValueType) * (_size - size));
+		return *this;
+	}
+
+	BitSetView& operator|=(ConstView _view) noexcept requires MUTABLE
+	{
+		auto size = std::min(_size, _view._size);
+		orBit(_data, _view._data, sizeof(ValueType) * size);
+		return *this;
+	}
+
+	BitSetView& operator^=(ConstView _view) noexcept requires MUTABLE
+	{
+		auto size = std::min(_size, _view._size);
+		xorBit(_data, _view._data, sizeof(ValueType) * size);
+		return *this;
+	}
+
+	// 获取元素内容
+	constexpr auto data() const noexcept
+	{
+		return _data;
+	}
+
+	// 获取元素数量
+	constexpr auto size() const noexcept
+	{
+		return _size;
+	}
+
+	// 位数量
+	constexpr auto capacity() const noexcept
+	{
+		return _size * BIT_SIZE;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return _size <= 0;
+	}
+
+	bool exist(SizeType _position) const noexcept
+	{
+		if (_position / BIT_SIZE >= _size) return false;
+
+		return (_data[_position / BIT_SIZE] & generate(_position)) != 0;
+	}
+
+	// 查找位置不小于_position之首个指定值位，限于元素范围
+	SizeType find(SizeType _position, bool _value = true) const noexcept
+	{
+		auto position = findBit<ValueType>(_data, _size, _position, _value);
+		return position < capacity() ? position : NPOS;
+	}
+
+	// 查找位置不大于_position之末个指定值位，限于元素范围
+	SizeType rfind(SizeType _position, bool _value = true) const noexcept
+	{
+		if (_size <= 0) return NPOS;
+
+		_position = std::min(_position, capacity() - 1);
+		return rfindBit<ValueType>(_data, _position, _value);
+	}
+
+	SizeType first(bool _value = true) const noexcept
+	{
+		return find(0, _value);
+	}
+
+	SizeType last(bool _value = true) const noexcept
+	{
+		return rfind(NPOS, _value);
+	}
+
+	SizeType next(SizeType _position, bool _value = true) const noexcept
+	{
+		return _position < NPOS ? find(_position + 1, _value) : NPOS;
+	}
+
+	SizeType prev(SizeType _position, bool _value = true) const noexcept
+	{
+		return _position > 0 ? rfind(_position - 1, _value) : NPOS;
+	}
+
+	// 遍历有效位
+	Iterator begin() const noexcept
+	{
+		return Iterator(_data, _size, 0);
+	}
+
+	Iterator end() const noexcept
+	{
+		return Iterator(_data, _size, _size);
+	}
+
+	// 统计有效位
+	SizeType count() const noexcept
+	{
+		return countBit(_data, sizeof(ValueType) * _size);
+	}
+
+	bool all() const noexcept
+	{
+		return allBit(_data, sizeof(ValueType) * _size, true);
+	}
+
+	bool any() const noexcept
+	{
+		return not none();
+	}
+
+	bool none() const noexcept
+	{
+		return allBit(_data, sizeof(ValueType) * _size, false);
+	}
+
+	BitSetView& set(SizeType _position, bool _value = true) noexcept \
+		requires MUTABLE
+	{
+		if (not _value) return reset(_position);
+
+		if (_position / BIT_SIZE < _size)
+			_data[_position / BIT_SIZE] |= generate(_position);
+		return *this;
+	}
+
+	BitSetView& set(SizeType _begin, SizeType _end, \
+		bool _value = true) noexcept requires MUTABLE
+	{
+		if (not _value) return reset(_begin, _end);
+
+		traverseBit<BIT_OPERATION_SET>(_data, _size, _begin, _end);
+		return *this;
+	}
+
+	BitSetView& set() noexcept requires MUTABLE
+	{
+		std::memset(_data, 0xFF, sizeof(ValueType) * _size);
+		return *this;
+	}
+
+	BitSetView& reset(SizeType _position) noexcept requires MUTABLE
+	{
+		if (_position / BIT_SIZE < _size)
+			_data[_position / BIT_SIZE] &= \
+				static_cast<ValueType>(~generate(_position));
+		return *this;
+	}
+
+	BitSetView& reset(SizeType _begin, SizeType _end) noexcept \
+		requires MUTABLE
+	{
+		traverseBit<BIT_OPERATION_RESET>(_data, _size, _begin, _end);
+		return *this;
+	}
+
+	BitSetView& reset() noexcept requires MUTABLE
+	{
+		std::memset(_data, 0, sizeof(ValueType) * _size);
+		return *this;
+	}
+
+	BitSetView& flip(SizeType _position) noexcept requires MUTABLE
+	{
+		if (_position / BIT_SIZE < _size)
+			_data[_position / BIT_SIZE] ^= generate(_position);
+		return *this;
+	}
+
+	BitSetView& flip(SizeType _begin, SizeType _end) noexcept \
+		requires MUTABLE
+	{
+		traverseBit<BIT_OPERATION_FLIP>(_data, _size, _begin, _end);
+		return *this;
+	}
+
+	BitSetView& flip() noexcept requires MUTABLE
+	{
+		flipBit(_data, sizeof(ValueType) * _size);
+		return *this;
+	}
+
+	// 复制为位集合
+	BitSet<ValueType> copy() const
+	{
+		return BitSet<ValueType>(_data, _size);
+	}
+};
+
+template <typename _ValueType>
+BitSetView(BitSet<_ValueType>&) -> BitSetView<_ValueType>;
+
+template <typename _ValueType>
+BitSetView(const BitSet<_ValueType>&) -> BitSetView<const _ValueType>;
+
+template <typename _ElementType, std::size_t _Extent>
+BitSetView(std::span<_ElementType, _Extent>) -> BitSetView<_ElementType>;
+
+ETERFREE_SPACE_END
@@ -0,0 +1,504 @@
+﻿#pragma once
+
+#include <bit>
+#include <cmath>
+#include <span>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "Allocator.hpp"
+#include "BitSet.hpp"
+#include "Common.hpp"
+#include "Eterfree/Platform/Core/CPU.h"
+
+ETERFREE_SPACE_BEGIN
+
+// 非加密散列：六十四位混合函数，雪崩良好
+constexpr std::uint64_t hashKey(std::uint64_t _key) noexcept
+{
+	_key ^= _key >> 33;
+	_key *= 0xFF51AFD7ED558CCDULL;
+	_key ^= _key >> 33;
+	_key *= 0xC4CEB9FE1A85EC53ULL;
+	_key ^= _key >> 33;
+	return _key;
+}
+
+// 字节序列之散列：每八字节混合一次，长度作为种子
+inline std::uint64_t hashKey(const void* _data, std::size_t _size) noexcept
+{
+	auto data = static_cast<const unsigned char*>(_data);
+	auto hash = 0x9E3779B97F4A7C15ULL ^ _size;
+
+	std::uint64_t word = 0;
+	for (; _size >= sizeof word; _size -= sizeof word)
+	{
+		std::memcpy(&word, data, sizeof word);
+		hash = hashKey(hash ^ word);
+		data += sizeof word;
+	}
+
+	word = 0;
+	std::memcpy(&word, data, _size);
+	return hashKey(hash ^ word);
+}
+
+/*
+ * 布隆过滤器之公共操作：派生类提供prefetch、add与test，参数为键之散列。
+ * 批量接口先散列并预取一批键所在缓存行，再逐个访问，以隐藏访存延迟。
+ */
+template <typename _Derived>
+class BloomFilterBase
+{
+public:
+	using KeyType = std::uint64_t;
+	using SizeType = std::size_t;
+
+	// 批量操作之预取深度
+	static constexpr SizeType BATCH_SIZE = 16;
+
+private:
+	_Derived& derived() noexcept
+	{
+		return static_cast<_Derived&>(*this);
+	}
+
+	const _Derived& derived() const noexcept
+	{
+		return static_cast<const _Derived&>(*this);
+	}
+
+	// 误判率范围，超出者取边界
+	static constexpr double MIN_RATE = 1e-12;
+	static constexpr double MAX_RATE = 0.5;
+
+protected:
+	// 误判率限于[MIN_RATE, MAX_RATE]，非数亦取MIN_RATE
+	static double clampRate(double _rate) noexcept
+	{
+		if (not (_rate > MIN_RATE)) return MIN_RATE;
+		return std::min(_rate, MAX_RATE);
+	}
+
+	// 预期元素数量与误判率之最优位数量，不超过位数量上限
+	static SizeType optimalBits(SizeType _count, double _rate) noexcept
+	{
+		constexpr auto MAX_BITS = static_cast<double>(SizeType(1) << (CHAR_BIT * sizeof(SizeType) - 2));
+
+		auto log2 = std::log(2.0);
+		auto bits = -static_cast<double>(_count) * std::log(clampRate(_rate)) / (log2 * log2);
+		return static_cast<SizeType>(std::ceil(std::clamp(bits, 1.0, MAX_BITS)));
+	}
+
+	// 误判率之最优散列数量
+	static SizeType optimalHashes(double _rate) noexcept
+	{
+		auto hashes = std::round(-std::log2(clampRate(_rate)));
+		return static_cast<SizeType>(std::max(hashes, 1.0));
+	}
+
+	// 双重散列生成第_index个探测值：步长为奇数，二的幂取模时互不相同
+	static constexpr std::uint64_t probe(std::uint64_t _hash, \
+		SizeType _index) noexcept
+	{
+		auto step = std::rotl(_hash, 32) | 1;
+		return _hash + _index * step;
+	}
+
+public:
+	void insert(KeyType _key)
+	{
+		derived().add(hashKey(_key));
+	}
+
+	void insert(const void* _data, SizeType _size)
+	{
+		derived().add(hashKey(_data, _size));
+	}
+
+	// 批量插入，预取后访问
+	void insert(std::span<const KeyType> _keys)
+	{
+		std::uint64_t buffer[BATCH_SIZE];
+		for (SizeType offset = 0; offset < _keys.size(); offset += BATCH_SIZE)
+		{
+			auto size = std::min(BATCH_SIZE, _keys.size() - offset);
+			for (SizeType index = 0; index < size; ++index)
+			{
+				buffer[index] = hashKey(_keys[offset + index]);
+				derived().prefetch(buffer[index]);
+			}
+
+			for (SizeType index = 0; index < size; ++index)
+				derived().add(buffer[index]);
+		}
+	}
+
+	// 可能存在；不存在则必不存在
+	bool exist(KeyType _key) const noexcept
+	{
+		return derived().test(hashKey(_key));
+	}
+
+	bool exist(const void* _data, SizeType _size) const noexcept
+	{
+		return derived().test(hashKey(_data, _size));
+	}
+
+	// 批量查询，结果写入_results，返回可能存在之数量
+	SizeType exist(std::span<const KeyType> _keys, \
+		bool* _results) const noexcept
+	{
+		std::uint64_t buffer[BATCH_SIZE];
+
+		SizeType counter = 0;
+		for (SizeType offset = 0; offset < _keys.size(); offset += BATCH_SIZE)
+		{
+			auto size = std::min(BATCH_SIZE, _keys.size() - offset);
+			for (SizeType index = 0; index < size; ++index)
+			{
+				buffer[index] = hashKey(_keys[offset + index]);
+				derived().prefetch(buffer[index]);
+			}
+
+			for (SizeType index = 0; index < size; ++index)
+			{
+				bool result = derived().test(buffer[index]);
+				_results[offset + index] = result;
+				counter += result;
+			}
+		}
+		return counter;
+	}
+};
+
+/*
+ * 布隆过滤器：位存储为位集合，位数量向上取整为二的幂。
+ * 每个键探测散列数量个位，各位通常位于不同缓存行。
+ */
+class BloomFilter final : \
+	public BloomFilterBase<BloomFilter>
+{
+	friend class BloomFilterBase<BloomFilter>;
+
+public:
+	using ValueType = std::uint64_t;
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+private:
+	BitSet<ValueType> _bitSet;
+	SizeType _mask; // 位数量减一
+	SizeType _hashes; // 散列数量
+
+private:
+	// 仅预取首个探测位：查询不存在之键多于首个探测位终止，且预取数量不超出未命中缓冲
+	void prefetch(std::uint64_t _hash) const noexcept
+	{
+		auto position = probe(_hash, 0) & _mask;
+		Platform::prefetch(_bitSet.data() + position / BIT_SIZE);
+	}
+
+	void add(std::uint64_t _hash) noexcept
+	{
+		auto data = _bitSet.data();
+		for (SizeType index = 0; index < _hashes; ++index)
+		{
+			auto position = probe(_hash, index) & _mask;
+			data[position / BIT_SIZE] |= generateBit<ValueType>(position % BIT_SIZE);
+		}
+	}
+
+	bool test(std::uint64_t _hash) const noexcept
+	{
+		auto data = _bitSet.data();
+		for (SizeType index = 0; index < _hashes; ++index)
+		{
+			auto position = probe(_hash, index) & _mask;
+			auto mask = generateBit<ValueType>(position % BIT_SIZE);
+			if ((data[position / BIT_SIZE] & mask) == 0) return false;
+		}
+		return true;
+	}
+
+public:
+	BloomFilter(SizeType _bits, SizeType _hashes) : \
+		_bitSet(std::bit_ceil(std::max(_bits, BIT_SIZE)) / BIT_SIZE), \
+		_mask(std::bit_ceil(std::max(_bits, BIT_SIZE)) - 1), \
+		_hashes(std::max<SizeType>(_hashes, 1)) {}
+
+	// 依预期元素数量与误判率确定规模，具名以免与按位数构造混淆；误判率超出范围则取边界
+	static BloomFilter optimal(SizeType _count, double _rate)
+	{
+		return BloomFilter(optimalBits(_count, _rate), optimalHashes(_rate));
+	}
+
+	auto bits() const noexcept
+	{
+		return _mask + 1;
+	}
+
+	auto hashes() const noexcept
+	{
+		return _hashes;
+	}
+
+	// 占用字节数
+	auto usage() const noexcept
+	{
+		return sizeof(ValueType) * _bitSet.size();
+	}
+
+	// 依有效位比例估计之误判率
+	double rate() const noexcept
+	{
+		auto ratio = static_cast<double>(_bitSet.count()) / bits();
+		return std::pow(ratio, static_cast<double>(_hashes));
+	}
+
+	void clear() noexcept
+	{
+		_bitSet.reset();
+	}
+};
+
+/*
+ * 分块布隆过滤器：每个键之所有探测位位于同一缓存行之块内，
+ * 单次访存完成插入与查询；同等空间下误判率略高于布隆过滤器。
+ * 元素按缓存行对齐分配，复制后块之位置不变。
+ */
+class BlockedBloomFilter final : \
+	public BloomFilterBase<BlockedBloomFilter>
+{
+	friend class BloomFilterBase<BlockedBloomFilter>;
+
+public:
+	using ValueType = std::uint64_t;
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+	// 缓存行字节数
+	static constexpr SizeType CACHE_LINE = 64;
+
+	// 块之位数量
+	static constexpr SizeType BLOCK_BITS = CHAR_BIT * CACHE_LINE;
+
+	// 块之元素数量
+	static constexpr SizeType BLOCK_SIZE = BLOCK_BITS / BIT_SIZE;
+
+private:
+	using Vector = std::vector<ValueType, \
+		AlignedAllocator<ValueType, CACHE_LINE>>;
+
+private:
+	Vector _vector;
+	SizeType _mask; // 块数量减一
+	SizeType _hashes; // 散列数量
+
+private:
+	// 散列所属块之首元素
+	const ValueType* block(std::uint64_t _hash) const noexcept
+	{
+		auto index = static_cast<SizeType>(_hash) & _mask;
+		return _vector.data() + index * BLOCK_SIZE;
+	}
+
+	ValueType* block(std::uint64_t _hash) noexcept
+	{
+		auto data = std::as_const(*this).block(_hash);
+		return const_cast<ValueType*>(data);
+	}
+
+	void prefetch(std::uint64_t _hash) const noexcept
+	{
+		Platform::prefetch(block(_hash));
+	}
+
+	// 块内探测值取自再次混合之散列，与块之选择无关
+	void add(std::uint64_t _hash) noexcept
+	{
+		auto data = block(_hash);
+		auto hash = hashKey(_hash);
+		for (SizeType index = 0; index < _hashes; ++index)
+		{
+			auto position = probe(hash, index) % BLOCK_BITS;
+			data[position / BIT_SIZE] |= generateBit<ValueType>(position % BIT_SIZE);
+		}
+	}
+
+	bool test(std::uint64_t _hash) const noexcept
+	{
+		auto data = block(_hash);
+		auto hash = hashKey(_hash);
+		for (SizeType index = 0; index < _hashes; ++index)
+		{
+			auto position = probe(hash, index) % BLOCK_BITS;
+			auto mask = generateBit<ValueType>(position % BIT_SIZE);
+			if ((data[position / BIT_SIZE] & mask) == 0) return false;
+		}
+		return true;
+	}
+
+public:
+	BlockedBloomFilter(SizeType _bits, SizeType _hashes) : \
+		_vector(std::bit_ceil(std::max(_bits, BLOCK_BITS) / BLOCK_BITS) \
+			* BLOCK_SIZE), \
+		_mask(std::bit_ceil(std::max(_bits, BLOCK_BITS) / BLOCK_BITS) - 1), \
+		_hashes(std::max<SizeType>(_hashes, 1)) {}
+
+	static BlockedBloomFilter optimal(SizeType _count, double _rate)
+	{
+		return BlockedBloomFilter(optimalBits(_count, _rate), optimalHashes(_rate));
+	}
+
+	auto bits() const noexcept
+	{
+		return (_mask + 1) * BLOCK_BITS;
+	}
+
+	auto hashes() const noexcept
+	{
+		return _hashes;
+	}
+
+	auto usage() const noexcept
+	{
+		return sizeof(ValueType) * _vector.size();
+	}
+
+	void clear() noexcept
+	{
+		std::fill(_vector.begin(), _vector.end(), 0);
+	}
+};
+
+/*
+ * 计数布隆过滤器：以四位计数器代替位，支持删除；计数器存储于位集合之元素。
+ * 计数器饱和后不再增减，以免删除引入漏判。空间为同等布隆过滤器之四倍。
+ */
+class CountingBloomFilter final : \
+	public BloomFilterBase<CountingBloomFilter>
+{
+	friend class BloomFilterBase<CountingBloomFilter>;
+
+public:
+	using ValueType = std::uint64_t;
+
+	// 计数器之位数量
+	static constexpr SizeType COUNTER_BITS = 4;
+
+	// 计数器最大值
+	static constexpr ValueType MAX_COUNTER = (1U << COUNTER_BITS) - 1;
+
+	// 单元素之计数器数量
+	static constexpr SizeType COUNTER_SIZE = \
+		CHAR_BIT * sizeof(ValueType) / COUNTER_BITS;
+
+private:
+	BitSet<ValueType> _bitSet;
+	SizeType _mask; // 计数器数量减一
+	SizeType _hashes; // 散列数量
+
+private:
+	ValueType counter(SizeType _position) const noexcept
+	{
+		auto element = _bitSet.data()[_position / COUNTER_SIZE];
+		return (element >> _position % COUNTER_SIZE * COUNTER_BITS) & MAX_COUNTER;
+	}
+
+	// 计数器增减一，饱和者不变
+	void update(SizeType _position, bool _increase) noexcept
+	{
+		if (counter(_position) >= MAX_COUNTER) return;
+
+		auto shift = _position % COUNTER_SIZE * COUNTER_BITS;
+		auto& element = _bitSet.data()[_position / COUNTER_SIZE];
+		if (_increase)
+			element += static_cast<ValueType>(1) << shift;
+		else
+			element -= static_cast<ValueType>(1) << shift;
+	}
+
+	void prefetch(std::uint64_t _hash) const noexcept
+	{
+		auto position = probe(_hash, 0) & _mask;
+		Platform::prefetch(_bitSet.data() + position / COUNTER_SIZE);
+	}
+
+	void add(std::uint64_t _hash) noexcept
+	{
+		for (SizeType index = 0; index < _hashes; ++index)
+			update(probe(_hash, index) & _mask, true);
+	}
+
+	bool test(std::uint64_t _hash) const noexcept
+	{
+		for (SizeType index = 0; index < _hashes; ++index)
+			if (counter(probe(_hash, index) & _mask) <= 0)
+				return false;
+		return true;
+	}
+
+	// 可能存在则删除；探测值重复之计数器亦重复递减，与插入对称
+	bool subtract(std::uint64_t _hash) noexcept
+	{
+		if (not test(_hash)) return false;
+
+		for (SizeType index = 0; index < _hashes; ++index)
+			update(probe(_hash, index) & _mask, false);
+		return true;
+	}
+
+public:
+	CountingBloomFilter(SizeType _counters, SizeType _hashes) : \
+		_bitSet(std::bit_ceil(std::max(_counters, COUNTER_SIZE)) / COUNTER_SIZE), \
+		_mask(std::bit_ceil(std::max(_counters, COUNTER_SIZE)) - 1), \
+		_hashes(std::max<SizeType>(_hashes, 1)) {}
+
+	static CountingBloomFilter optimal(SizeType _count, double _rate)
+	{
+		return CountingBloomFilter(optimalBits(_count, _rate), optimalHashes(_rate));
+	}
+
+	// 计数器数量
+	auto counters() const noexcept
+	{
+		return _mask + 1;
+	}
+
+	auto hashes() const noexcept
+	{
+		return _hashes;
+	}
+
+	auto usage() const noexcept
+	{
+		return sizeof(ValueType) * _bitSet.size();
+	}
+
+	// 删除先前插入之键，键不存在则返回假；删除未插入之键可导致漏判
+	bool remove(KeyType _key) noexcept
+	{
+		return subtract(hashKey(_key));
+	}
+
+	bool remove(const void* _data, SizeType _size) noexcept
+	{
+		return subtract(hashKey(_data, _size));
+	}
+
+	void clear() noexcept
+	{
+		_bitSet.reset();
+	}
+};
+
+ETERFREE_SPACE_END
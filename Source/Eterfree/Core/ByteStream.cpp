@@ -9,18 +9,37 @@ ETERFREE_SPACE_BEGIN
 
 using namespace Platform;
 
+// 读取头部字段，无对齐要求
+template <typename _Type>
+static _Type load(const char* _data, bool _endian) noexcept
+{
+	return _endian ? BigEndian<_Type>::read(_data) \
+		: NativeEndian<_Type>::read(_data);
+}
+
+// 按字累加
+template <typename _Type, std::endian _ORDER>
+static std::uint64_t accumulate(const char* _data, \
+	std::size_t _size) noexcept
+{
+	std::uint64_t sum = 0;
+	for (decltype(_size) index = 0; \
+		index < _size; index += sizeof(_Type))
+		sum += EndianValue<_Type, _ORDER>::read(_data + index);
+	return sum;
+}
+
 auto ByteStream::getMaxSize(SizeType _maxSize, \
-	bool _checksum) noexcept -> SizeType
+	bool _checksum, bool _channel) noexcept -> SizeType
 {
 	if (_maxSize <= 0) _maxSize = MAX_SIZE;
 
-	if (_maxSize < SIZE) return 0;
+	auto extraSize = SIZE;
+	if (_checksum) extraSize += SIZE;
+	if (_channel) extraSize += SIZE;
 
-	_maxSize -= SIZE;
-	if (_checksum)
-		_maxSize = _maxSize >= SIZE ? \
-			_maxSize - SIZE : 0;
-	return _maxSize;
+	return _maxSize >= extraSize ? \
+		_maxSize - extraSize : 0;
 }
 
 auto ByteStream::calculateSum(const char* _data, \
@@ -33,26 +52,9 @@ auto ByteStream::calculateSum(const char* _data, \
 	auto size = _size % SIZE;
 	_size -= size;
 
-	std::uint64_t sum = 0;
-	auto address = reinterpret_cast<SizeType>(_data);
-	if (address % ALIGNMENT == 0)
-		for (decltype(_size) index = 0; \
-			index < _size; index += SIZE)
-		{
-			auto data = _data + index;
-			auto value = *reinterpret_cast<const StreamSize*>(data);
-			if (_endian) value = ntohss(value);
-			sum += value;
-		}
-	else
-		for (decltype(_size) index = 0; \
-			index < _size; index += SIZE)
-		{
-			StreamSize value = 0;
-			std::memcpy(&value, _data + index, SIZE);
-			if (_endian) value = ntohss(value);
-			sum += value;
-		}
+	auto sum = _endian ? \
+		accumulate<StreamSize, std::endian::big>(_data, _size) : \
+		accumulate<StreamSize, std::endian::native>(_data, _size);
 
 	if (size > 0)
 	{
@@ -78,18 +80,40 @@ auto ByteStream::convertSum(StreamSize _sum, \
 bool ByteStream::checkSum(const char* _data, \
 	StreamSize _sum, bool _endian)
 {
-	decltype(_sum) sum = 0;
-	auto address = reinterpret_cast<SizeType>(_data);
-	if (address % ALIGNMENT == 0)
-		sum = *reinterpret_cast<const StreamSize*>(_data);
-	else
-		std::memcpy(&sum, _data, SIZE);
-
-	if (_endian)
-		sum = ntoh<StreamSize, StreamSize>(sum);
+	auto sum = load<StreamSize>(_data, _endian);
 	return _sum + sum == MAX_SIZE;
 }
 
+void ByteStream::trim(ChannelQueue& _queues) noexcept
+{
+	for (auto iterator = _queues.begin(); \
+		iterator != _queues.end();)
+		if (iterator->second.empty())
+			iterator = _queues.erase(iterator);
+		else
+			++iterator;
+}
+
+void ByteStream::update(SizeType _usage) noexcept
+{
+	this->_usage = _usage;
+
+	auto high = highWatermark();
+	bool congested = _congested;
+	if (high <= 0)
+		congested = false;
+	else if (_usage >= high)
+		congested = true;
+	else if (_usage <= lowWatermark())
+		congested = false;
+
+	if (congested != _congested)
+	{
+		_congested = congested;
+		if (_notifier) _notifier(congested);
+	}
+}
+
 void ByteStream::clearFlag() noexcept
 {
 	FlagType flag;
@@ -98,20 +122,115 @@ void ByteStream::clearFlag() noexcept
 		std::memory_order::relaxed);
 }
 
+bool ByteStream::alignment(SizeType _alignment) noexcept
+{
+	if (_alignment > MAX_ALIGNMENT \
+		or (_alignment & (_alignment - 1)) != 0)
+		return false;
+
+	this->_alignment.store(_alignment, \
+		std::memory_order::relaxed);
+	return true;
+}
+
+void ByteStream::watermark(SizeType _high, \
+	SizeType _low) noexcept
+{
+	if (_low > _high) _low = _high;
+
+	_highWatermark.store(_high, \
+		std::memory_order::relaxed);
+	_lowWatermark.store(_low, \
+		std::memory_order::relaxed);
+}
+
 auto OutputByteStream::getSize(SizeType _offset) const \
 -> StreamSize
 {
-	StreamSize size = 0;
-	auto data = _buffer.data() + _offset;
-	auto address = reinterpret_cast<SizeType>(data);
-	if (address % ALIGNMENT == 0)
-		size = *reinterpret_cast<const StreamSize*>(data);
-	else
-		std::memcpy(&size, data, SIZE);
+	return load<StreamSize>(_buffer.data() + _offset, \
+		existFlag(FLAG_TYPE_ENDIAN));
+}
+
+bool OutputByteStream::ready(ChannelType _channel, \
+	SizeType _size) const noexcept
+{
+	auto iterator = _credits.find(_channel);
+	return iterator == _credits.end() \
+		or iterator->second >= _size;
+}
+
+auto OutputByteStream::select(Lane& _lane, \
+	ChannelType& _channel) noexcept -> QueueType*
+{
+	auto& queues = _lane._queues;
+	auto cursor = queues.lower_bound(_lane._cursor);
+	for (auto round = 0; round < 2; ++round)
+	{
+		auto begin = round == 0 ? cursor : queues.begin();
+		auto end = round == 0 ? queues.end() : cursor;
+		for (auto iterator = begin; iterator != end; ++iterator)
+		{
+			auto& [channel, queue] = *iterator;
+			if (queue.empty() \
+				or not ready(channel, queue.front().size()))
+				continue;
+
+			// 下次自后继信道开始轮询
+			_lane._cursor = channel + 1;
+			_channel = channel;
+			return &queue;
+		}
+	}
+	return nullptr;
+}
+
+auto OutputByteStream::schedule(Lane*& _lane, \
+	ChannelType& _channel) noexcept -> QueueType*
+{
+	for (auto round = 0; round < 2; ++round)
+	{
+		bool exhausted = false;
+		for (auto& lane : _lanes)
+		{
+			if (lane._size <= 0) continue;
+
+			if (lane._credit <= 0)
+			{
+				exhausted = true;
+				continue;
+			}
+
+			if (auto queue = select(lane, _channel))
+			{
+				_lane = &lane;
+				return queue;
+			}
+		}
 
-	if (existFlag(FLAG_TYPE_ENDIAN))
-		size = ntoh<StreamSize, StreamSize>(size);
-	return size;
+		if (not exhausted) break;
+
+		// 开启新一轮调度
+		for (auto& lane : _lanes)
+			lane._credit = lane._weight.load(std::memory_order::relaxed);
+	}
+	return nullptr;
+}
+
+OutputByteStream::OutputByteStream(SizeType _maxSize, \
+	SizeType _capacity, std::pmr::memory_resource* _resource) : \
+	ByteStream(_maxSize), _offset(0), _buffer(_resource)
+{
+	// 默认权重：控制4，交互2，批量1
+	constexpr SizeType WEIGHT[LANE_TYPE_SIZE] = { 4, 2, 1 };
+
+	for (std::size_t index = 0; index < _lanes.size(); ++index)
+	{
+		auto& lane = _lanes[index];
+		lane._capacity.store(_capacity, std::memory_order::relaxed);
+		lane._weight.store(WEIGHT[index], std::memory_order::relaxed);
+		lane._credit = lane._size = 0;
+		lane._cursor = 0;
+	}
 }
 
 void OutputByteStream::limit(SizeType _maxSize, \
@@ -119,15 +238,45 @@ void OutputByteStream::limit(SizeType _maxSize, \
 {
 	storeMaxSize(_maxSize);
 
-	this->_capacity.store(_capacity, \
-		std::memory_order::relaxed);
+	for (auto& lane : _lanes)
+		lane._capacity.store(_capacity, \
+			std::memory_order::relaxed);
 }
 
-bool OutputByteStream::idle() const noexcept
+auto OutputByteStream::credit(ChannelType _channel) const noexcept \
+-> SizeType
 {
-	auto capacity = this->capacity();
+	auto iterator = _credits.find(_channel);
+	return iterator != _credits.end() ? \
+		iterator->second : MAX_SIZE;
+}
+
+void OutputByteStream::grant(ChannelType _channel, \
+	SizeType _credit)
+{
+	auto& credit = _credits[_channel];
+	credit = credit < MAX_SIZE - _credit ? \
+		credit + _credit : MAX_SIZE;
+}
+
+bool OutputByteStream::empty() const noexcept
+{
+	for (const auto& lane : _lanes)
+		if (lane._size > 0) return false;
+	return _buffer.empty();
+}
+
+bool OutputByteStream::idle(LANE_TYPE _lane) const noexcept
+{
+	if (_lane >= LANE_TYPE_SIZE) return false;
+
+	// 控制报文不受拥塞约束，以免拥塞时无法调度
+	if (_lane != LANE_TYPE_CONTROL \
+		and congested()) return false;
+
+	auto capacity = this->capacity(_lane);
 	return capacity <= 0 \
-		or _queue.size() < capacity;
+		or _lanes[_lane]._size < capacity;
 }
 
 const char* OutputByteStream::data(SizeType& _size)
@@ -135,15 +284,26 @@ const char* OutputByteStream::data(SizeType& _size)
 	auto flag = loadFlag();
 	bool endian = existFlag(flag, FLAG_TYPE_ENDIAN);
 	bool checksum = existFlag(flag, FLAG_TYPE_CHECKSUM);
+	bool multiplex = existFlag(flag, FLAG_TYPE_CHANNEL);
 
 	auto maxSize = loadMaxSize();
-	maxSize = getMaxSize(maxSize, checksum);
-	while (_buffer.size() - _offset < _size \
-		and not _queue.empty())
+	if (maxSize <= 0) maxSize = MAX_SIZE;
+
+	auto alignment = this->alignment();
+	auto headerSize = getHeaderSize(flag, alignment);
+	auto padding = headerSize - SIZE - getExtraSize(flag);
+
+	while (_buffer.size() - _offset < _size)
 	{
-		const auto& packet = _queue.front();
+		Lane* lane = nullptr;
+		ChannelType channel = 0;
+		auto queue = schedule(lane, channel);
+		if (queue == nullptr) break;
+
+		const auto& packet = queue->front();
+		auto payloadSize = align(packet.size(), alignment);
 		if (_buffer.size() > maxSize \
-			or packet.size() > maxSize - _buffer.size())
+			or headerSize + payloadSize > maxSize - _buffer.size())
 			break;
 
 		auto size = static_cast<StreamSize>(packet.size());
@@ -151,6 +311,18 @@ const char* OutputByteStream::data(SizeType& _size)
 
 		auto data = reinterpret_cast<const char*>(&size);
 		_buffer.append(data, SIZE);
+		increase(SIZE);
+
+		// 标识所属信道
+		if (multiplex)
+		{
+			auto value = static_cast<StreamSize>(channel);
+			if (endian) value = hton(value);
+
+			data = reinterpret_cast<const char*>(&value);
+			_buffer.append(data, SIZE);
+			increase(SIZE);
+		}
 
 		// 生成特定累加和
 		if (checksum)
@@ -161,30 +333,48 @@ const char* OutputByteStream::data(SizeType& _size)
 
 			data = reinterpret_cast<const char*>(&sum);
 			_buffer.append(data, SIZE);
+			increase(SIZE);
 		}
 
+		if (auto iterator = _credits.find(channel); \
+			iterator != _credits.end())
+			iterator->second -= packet.size();
+
+		// 填充头部，使负载起始于对齐边界
+		_buffer.append(padding, '\0');
 		_buffer.append(packet);
-		_queue.pop_front();
+		_buffer.append(payloadSize - packet.size(), '\0');
+		increase(padding + payloadSize - packet.size());
+		queue->pop_front();
+
+		--lane->_size;
+		--lane->_credit;
 	}
 
 	_size = _buffer.size() - _offset;
 	return _buffer.data() + _offset;
 }
 
-bool OutputByteStream::put(const char* _data, \
-	SizeType _size)
+bool OutputByteStream::put(ChannelType _channel, \
+	const char* _data, SizeType _size, LANE_TYPE _lane)
 {
 	if (_data == nullptr and _size != 0)
 		return false;
 
-	bool checksum = existFlag(FLAG_TYPE_CHECKSUM);
-	auto maxSize = loadMaxSize();
-	maxSize = getMaxSize(maxSize, checksum);
-	if (_size > maxSize) return false;
+	auto flag = loadFlag();
+	bool multiplex = existFlag(flag, FLAG_TYPE_CHANNEL);
+	if (_channel != 0 and not multiplex)
+		return false;
 
-	if (not idle()) return false;
+	if (not fit(loadMaxSize(), flag, alignment(), _size))
+		return false;
+
+	if (not idle(_lane)) return false;
 
-	_queue.emplace_back(_data, _size);
+	auto& lane = _lanes[_lane];
+	lane._queues[_channel].emplace_back(_data, _size);
+	++lane._size;
+	increase(_size);
 	return true;
 }
 
@@ -192,6 +382,8 @@ void OutputByteStream::take(SizeType _size)
 {
 	if (_size >= _buffer.size() - _offset)
 	{
+		decrease(_buffer.size());
+
 		_offset = 0;
 		_buffer.clear();
 		return;
@@ -199,35 +391,47 @@ void OutputByteStream::take(SizeType _size)
 
 	_offset += _size;
 
-	auto extraSize = SIZE;
-	if (existFlag(FLAG_TYPE_CHECKSUM))
-		extraSize += SIZE;
+	auto alignment = this->alignment();
+	auto headerSize = getHeaderSize(loadFlag(), alignment);
 
 	decltype(_offset) offset = 0;
 	decltype(offset) totalSize = 0;
 	do
 	{
 		offset += totalSize;
-		if (_offset - offset < extraSize)
+		if (_offset - offset < headerSize)
 			break;
 
 		auto size = getSize(offset);
-		totalSize = extraSize + size;
+		totalSize = headerSize + align(size, alignment);
 	} while (_offset - offset >= totalSize);
 
 	if (offset > 0)
 	{
 		_buffer.erase(0, offset);
 		_offset -= offset;
+		decrease(offset);
 	}
 }
 
 void OutputByteStream::clear() noexcept
 {
-	_queue.clear();
+	for (auto& lane : _lanes)
+	{
+		lane._queues.clear();
+		lane._size = 0;
+	}
 
 	_offset = 0;
 	_buffer.clear();
+	update(0);
+}
+
+void OutputByteStream::trim()
+{
+	for (auto& lane : _lanes)
+		ByteStream::trim(lane._queues);
+	ByteStream::trim(_buffer);
 }
 
 bool InputByteStream::getSize()
@@ -235,55 +439,97 @@ bool InputByteStream::getSize()
 	if (_buffer.size() - _offset < SIZE)
 		return false;
 
-	StreamSize size = 0;
-	auto data = _buffer.data() + _offset;
-	auto address = reinterpret_cast<SizeType>(data);
-	if (address % ALIGNMENT == 0)
-		size = *reinterpret_cast<const StreamSize*>(data);
-	else
-		std::memcpy(&size, data, SIZE);
-
-	if (existFlag(FLAG_TYPE_ENDIAN))
-		size = ntoh<StreamSize, StreamSize>(size);
-
-	_size = size;
+	_size = load<StreamSize>(_buffer.data() + _offset, \
+		existFlag(FLAG_TYPE_ENDIAN));
 	_offset += static_cast<decltype(_offset)>(SIZE);
 	return true;
 }
 
-bool InputByteStream::getPacket()
+void InputByteStream::getChannel()
+{
+	auto flag = loadFlag();
+	if (not existFlag(flag, FLAG_TYPE_CHANNEL))
+	{
+		_channel = 0;
+		return;
+	}
+
+	_channel = load<StreamSize>(_buffer.data() + _offset, \
+		existFlag(flag, FLAG_TYPE_ENDIAN));
+}
+
+bool InputByteStream::getPacket(SizeType _extraSize, \
+	bool _pending, const Visitor& _visitor, SizeType& _packets)
 {
 	bool result = true;
-	decltype(_size) size = 0;
 
-	// 检验特定累加和
 	auto flag = loadFlag();
+	auto data = _buffer.data() + _offset;
+
+	// 检验特定累加和
 	if (existFlag(flag, FLAG_TYPE_CHECKSUM))
 	{
 		bool endian = existFlag(flag, \
 			FLAG_TYPE_ENDIAN);
-		auto data = _buffer.data() + _offset;
+		auto size = existFlag(flag, FLAG_TYPE_CHANNEL) ? SIZE : 0;
 
-		size = static_cast<decltype(size)>(SIZE);
-		auto sum = calculateSum(data + size, \
+		auto sum = calculateSum(data + _extraSize, \
 			_size, endian);
-		result = checkSum(data, sum, endian);
+		result = checkSum(data + size, sum, endian);
 	}
 
-	if (result)
-		_queue.emplace_back(_buffer, \
-			_offset + size, _size);
-	return result;
+	if (not result) return false;
+
+	// 信道无排队数据包时就地处理负载，以免乱序
+	data += _extraSize;
+	if (not _pending and _visitor \
+		and count(_queues, _channel) <= 0 \
+		and _visitor(_channel, data, _size))
+		return true;
+
+	// 字节数由flushBuffer统一更新
+	auto& queues = _pending ? this->_pending : _queues;
+	queues[_channel].emplace_back(data, _size);
+	if (_pending) _pendingSize += _size;
+	_packets += _size;
+	return true;
+}
+
+void InputByteStream::promote()
+{
+	for (auto& [channel, pending] : _pending)
+	{
+		if (pending.empty() \
+			or not available(channel))
+			continue;
+
+		auto& queue = _queues[channel];
+		do
+		{
+			_pendingSize -= pending.front().size();
+			queue.push_back(std::move(pending.front()));
+			pending.pop_front();
+		} while (not pending.empty() \
+			and available(channel));
+	}
 }
 
-bool InputByteStream::flushBuffer()
+bool InputByteStream::flushBuffer(const Visitor& _visitor)
 {
 	bool result = true;
 	decltype(_offset) offset = 0;
+	SizeType packets = 0;
 
-	StreamSize extraSize = 0;
-	if (existFlag(FLAG_TYPE_CHECKSUM))
-		extraSize = static_cast<StreamSize>(SIZE);
+	promote();
+
+	auto maxSize = loadMaxSize();
+	if (maxSize <= 0) maxSize = MAX_SIZE;
+
+	auto flag = loadFlag();
+	bool multiplex = existFlag(flag, FLAG_TYPE_CHANNEL);
+
+	auto alignment = this->alignment();
+	auto extraSize = getHeaderSize(flag, alignment) - SIZE;
 
 	do
 	{
@@ -291,27 +537,49 @@ bool InputByteStream::flushBuffer()
 			and not getSize())
 			break;
 
+		auto payloadSize = align(_size, alignment);
 		auto size = _buffer.size() - _offset;
-		if (size >= _size \
-			and size - _size >= extraSize \
-			and idle())
-		{
-			result = getPacket();
+		if (size < payloadSize \
+			or size - payloadSize < extraSize)
+			break;
 
-			_offset += _size + extraSize;
-			offset = _offset;
-			_size = 0;
-		}
-	} while (_size <= 0 and result);
+		/*
+		 * 复用信道时，队列已满之信道滞留数据包，继续解析其他信道；
+		 * 未复用则无其他信道，数据包留于缓冲以施加背压。
+		 */
+		getChannel();
+		bool pending = not available(_channel) \
+			or count(_pending, _channel) > 0;
+		if (pending and (not multiplex or _pendingSize >= maxSize \
+			or _size > maxSize - _pendingSize))
+			break;
+
+		result = getPacket(extraSize, pending, \
+			_visitor, packets);
+
+		_offset += static_cast<decltype(_offset)>(payloadSize + extraSize);
+		offset = _offset;
+		_size = 0;
+	} while (result);
 
 	if (offset > 0)
 	{
-		_buffer.erase(0, offset);
+		_buffer.erase(_buffer.begin(), _buffer.begin() + offset);
 		_offset -= offset;
+
+		// 数据包移入队列，帧头与填充随缓冲释放，一次更新净变化
+		update(usage() - offset + packets);
 	}
 	return result;
 }
 
+bool InputByteStream::available(ChannelType _channel) const noexcept
+{
+	auto capacity = this->capacity();
+	return capacity <= 0 \
+		or count(_queues, _channel) < capacity;
+}
+
 void InputByteStream::limit(SizeType _maxSize, \
 	SizeType _capacity) noexcept
 {
@@ -321,15 +589,35 @@ void InputByteStream::limit(SizeType _maxSize, \
 		std::memory_order::relaxed);
 }
 
+bool InputByteStream::empty() const noexcept
+{
+	for (const auto& [channel, queue] : _queues)
+		if (not queue.empty()) return false;
+	return true;
+}
+
 bool InputByteStream::idle() const noexcept
 {
-	auto capacity = this->capacity();
-	return capacity <= 0 \
-		or _queue.size() < capacity;
+	if (congested()) return false;
+
+	// 默认信道或有滞留数据包之信道队列已满则暂停接收
+	if (auto capacity = this->capacity(); capacity > 0)
+	{
+		if (count(_queues, 0) >= capacity) return false;
+
+		for (const auto& [channel, pending] : _pending)
+			if (not pending.empty() \
+				and count(_queues, channel) >= capacity)
+				return false;
+	}
+
+	// 滞留数据包达到上限则暂停接收
+	auto maxSize = loadMaxSize();
+	return maxSize <= 0 or _pendingSize < maxSize;
 }
 
-bool InputByteStream::put(const char* _data, \
-	SizeType _size, SizeType& _offset)
+bool InputByteStream::put(const char* _data, SizeType _size, \
+	SizeType& _offset, const Visitor& _visitor)
 {
 	auto maxSize = loadMaxSize();
 	if (maxSize <= 0) maxSize = MAX_SIZE;
@@ -341,17 +629,19 @@ bool InputByteStream::put(const char* _data, \
 	if ((_size -= _offset) > size)
 		_size = size;
 
-	_buffer.append(_data + _offset, _size);
+	_buffer.insert(_buffer.end(), _data + _offset, \
+		_data + _offset + _size);
 	_offset += _size;
-	return flushBuffer();
+	increase(_size);
+	return flushBuffer(_visitor);
 }
 
 bool InputByteStream::put(const char* _data, \
-	SizeType _size)
+	SizeType _size, const Visitor& _visitor)
 {
 	decltype(_size) offset = 0;
 	while (offset < _size)
-		if (not put(_data, _size, offset))
+		if (not put(_data, _size, offset, _visitor))
 		{
 			reset();
 			return false;
@@ -359,13 +649,43 @@ bool InputByteStream::put(const char* _data, \
 	return true;
 }
 
-bool InputByteStream::take(Buffer& _packet) noexcept
+bool InputByteStream::take(ChannelType _channel, \
+	Buffer& _packet) noexcept
 {
-	if (_queue.empty()) return false;
+	auto iterator = _queues.find(_channel);
+	if (iterator == _queues.end() \
+		or iterator->second.empty())
+		return false;
 
-	_packet = std::move(_queue.front());
-	_queue.pop_front();
+	auto& queue = iterator->second;
+	_packet = std::move(queue.front());
+	queue.pop_front();
+	decrease(_packet.size());
 	return true;
 }
 
+bool InputByteStream::take(ChannelType _channel, \
+	QueueType& _queue) noexcept
+{
+	// 信道无数据包：_queue保持不变，亦不为交换分配队列
+	auto iterator = _queues.find(_channel);
+	if (iterator == _queues.end() \
+		or iterator->second.empty())
+		return false;
+
+	SizeType input = 0;
+	for (const auto& packet : _queue)
+		input += packet.size();
+
+	iterator->second.swap(_queue);
+
+	SizeType output = 0;
+	for (const auto& packet : _queue)
+		output += packet.size();
+
+	// 一次更新净变化，避免瞬时峰值越过水位
+	update(usage() - output + input);
+	return not _queue.empty();
+}
+
 ETERFREE_SPACE_END
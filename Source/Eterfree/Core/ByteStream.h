@@ -2,10 +2,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 #include <deque>
+#include <map>
+#include <array>
 #include <atomic>
+#include <memory_resource>
 
+#include "Allocator.hpp"
 #include "BitSet.hpp"
 #include "Common.hpp"
 
@@ -18,6 +24,7 @@ public:
 	{
 		FLAG_TYPE_ENDIAN,
 		FLAG_TYPE_CHECKSUM,
+		FLAG_TYPE_CHANNEL,
 	};
 
 protected:
@@ -26,20 +33,51 @@ protected:
 public:
 	using FlagType = std::uint32_t;
 	using SizeType = std::size_t;
+	using ChannelType = std::uint32_t;
 
 	using Buffer = std::string;
 	using QueueType = std::deque<Buffer>;
 
+	// 水位通知：参数为是否进入拥塞状态
+	using Notifier = std::function<void(bool)>;
+
+	// 就地访问负载，返回true表示已处理
+	using Visitor = std::function<bool(ChannelType, const char*, SizeType)>;
+
+protected:
+	// 各信道之数据包队列，按需创建，空闲时可释放
+	using ChannelQueue = std::map<ChannelType, QueueType>;
+
 protected:
-	static constexpr auto ALIGNMENT = alignof(StreamSize);
 	static constexpr auto SIZE = sizeof(StreamSize);
 
 public:
 	static constexpr auto MAX_SIZE = UINT32_MAX;
 
+	// 负载对齐上限，亦为接收缓冲之对齐
+	static constexpr SizeType MAX_ALIGNMENT = 64;
+
+protected:
+	// 按最大对齐自内存资源分配之接收缓冲
+	using AlignedBuffer = std::vector<char, \
+		ResourceAllocator<char, MAX_ALIGNMENT>>;
+
+	// 自内存资源分配之发送缓冲
+	using StageBuffer = std::pmr::string;
+
 protected:
 	std::atomic<FlagType> _flag;
 	std::atomic<SizeType> _maxSize;
+	std::atomic<SizeType> _alignment;
+
+private:
+	// 字节水位：高于高水位进入拥塞，低于低水位解除拥塞
+	std::atomic<SizeType> _highWatermark;
+	std::atomic<SizeType> _lowWatermark;
+
+	SizeType _usage; // 队列与缓冲之字节数
+	bool _congested;
+	Notifier _notifier;
 
 public:
 	static bool existFlag(FlagType _flag, FLAG_TYPE _type) noexcept
@@ -59,7 +97,7 @@ public:
 	}
 
 	static SizeType getMaxSize(SizeType _maxSize, \
-		bool _checksum) noexcept;
+		bool _checksum, bool _channel = false) noexcept;
 
 	static StreamSize calculateSum(const char* _data, \
 		SizeType _size, bool _endian);
@@ -70,6 +108,63 @@ public:
 		StreamSize _sum, bool _endian);
 
 protected:
+	// 数据包头部之附加字节数，不含长度字段
+	static SizeType getExtraSize(FlagType _flag) noexcept
+	{
+		SizeType size = 0;
+		if (existFlag(_flag, FLAG_TYPE_CHANNEL)) size += SIZE;
+		if (existFlag(_flag, FLAG_TYPE_CHECKSUM)) size += SIZE;
+		return size;
+	}
+
+	// 向上对齐，对齐不大于一则不变
+	static SizeType align(SizeType _size, \
+		SizeType _alignment) noexcept
+	{
+		return _alignment > 1 ? \
+			(_size + _alignment - 1) & ~(_alignment - 1) : _size;
+	}
+
+	// 数据包头部字节数，含长度字段与对齐填充
+	static SizeType getHeaderSize(FlagType _flag, \
+		SizeType _alignment) noexcept
+	{
+		return align(SIZE + getExtraSize(_flag), _alignment);
+	}
+
+	// 数据包帧不超过上限
+	static bool fit(SizeType _maxSize, FlagType _flag, \
+		SizeType _alignment, SizeType _size) noexcept
+	{
+		if (_maxSize <= 0) _maxSize = MAX_SIZE;
+
+		auto headerSize = getHeaderSize(_flag, _alignment);
+		return headerSize <= _maxSize and _size <= _maxSize - headerSize \
+			and align(_size, _alignment) <= _maxSize - headerSize;
+	}
+
+	// 信道之数据包数量
+	static SizeType count(const ChannelQueue& _queues, \
+		ChannelType _channel) noexcept
+	{
+		auto iterator = _queues.find(_channel);
+		return iterator != _queues.end() ? \
+			iterator->second.size() : 0;
+	}
+
+	// 释放空队列
+	static void trim(ChannelQueue& _queues) noexcept;
+
+	// 释放缓冲容量
+	template <typename _Buffer>
+	static void trim(_Buffer& _buffer)
+	{
+		if (_buffer.empty())
+			_Buffer(_buffer.get_allocator()).swap(_buffer);
+		else
+			_buffer.shrink_to_fit();
+	}
+
 	auto loadMaxSize() const noexcept
 	{
 		return _maxSize.load(std::memory_order::relaxed);
@@ -81,9 +176,24 @@ protected:
 			std::memory_order::relaxed);
 	}
 
+	// 依据字节数变化，检测是否越过水位
+	void update(SizeType _usage) noexcept;
+
+	void increase(SizeType _size) noexcept
+	{
+		update(_usage + _size);
+	}
+
+	void decrease(SizeType _size) noexcept
+	{
+		update(_usage > _size ? _usage - _size : 0);
+	}
+
 public:
 	ByteStream(SizeType _maxSize = 0) noexcept : \
-		_flag(0), _maxSize(_maxSize) {}
+		_flag(0), _maxSize(_maxSize), _alignment(0), \
+		_highWatermark(0), _lowWatermark(0), \
+		_usage(0), _congested(false) {}
 
 	virtual ~ByteStream() noexcept {}
 
@@ -116,45 +226,193 @@ public:
 	}
 
 	void clearFlag() noexcept;
+
+	auto alignment() const noexcept
+	{
+		return _alignment.load(std::memory_order::relaxed);
+	}
+
+	/*
+	 * 设置负载对齐：填充头部与负载，使负载起始于对齐边界，
+	 * 须为二之幂且不超过MAX_ALIGNMENT，零或一表示不填充。
+	 * 收发双方须一致，且仅于字节流为空时修改。
+	 */
+	bool alignment(SizeType _alignment) noexcept;
+
+	auto highWatermark() const noexcept
+	{
+		return _highWatermark.load(std::memory_order::relaxed);
+	}
+
+	auto lowWatermark() const noexcept
+	{
+		return _lowWatermark.load(std::memory_order::relaxed);
+	}
+
+	// 设置字节水位，高水位为零表示不限制
+	void watermark(SizeType _high, SizeType _low) noexcept;
+
+	// 注册水位通知，于越过水位之线程调用，不得抛出异常
+	void notify(const Notifier& _notifier)
+	{
+		this->_notifier = _notifier;
+	}
+
+	// 占用字节数
+	auto usage() const noexcept
+	{
+		return _usage;
+	}
+
+	// 字节数越过高水位，尚未回落至低水位
+	bool congested() const noexcept
+	{
+		return _congested;
+	}
 };
 
 class OutputByteStream : public ByteStream
 {
-	std::atomic<SizeType> _capacity;
-	QueueType _queue;
+public:
+	// 优先级通道，数值越小优先级越高
+	enum LANE_TYPE : std::uint8_t
+	{
+		LANE_TYPE_CONTROL,
+		LANE_TYPE_INTERACTIVE,
+		LANE_TYPE_BULK,
+		LANE_TYPE_SIZE
+	};
+
+private:
+	struct Lane
+	{
+		std::atomic<SizeType> _capacity;
+		std::atomic<SizeType> _weight;
+
+		SizeType _credit; // 本轮剩余配额
+		SizeType _size; // 数据包数量
+
+		ChannelType _cursor; // 信道轮询起点
+		ChannelQueue _queues;
+	};
+
+private:
+	std::array<Lane, LANE_TYPE_SIZE> _lanes;
+
+	// 信道流量配额（字节），缺省不限制
+	std::map<ChannelType, SizeType> _credits;
 
 	SizeType _offset;
-	Buffer _buffer;
+	StageBuffer _buffer;
 
 private:
 	StreamSize getSize(SizeType _offset) const;
 
+	// 信道配额足以发送数据包
+	bool ready(ChannelType _channel, \
+		SizeType _size) const noexcept;
+
+	// 通道内轮询选取信道
+	QueueType* select(Lane& _lane, \
+		ChannelType& _channel) noexcept;
+
+	// 调度下一数据包所在通道与信道
+	QueueType* schedule(Lane*& _lane, \
+		ChannelType& _channel) noexcept;
+
 public:
-	OutputByteStream(SizeType _maxSize = 0, SizeType _capacity = 0) : \
-		ByteStream(_maxSize), _capacity(_capacity), _offset(0) {}
+	// 发送缓冲自_resource分配
+	OutputByteStream(SizeType _maxSize = 0, SizeType _capacity = 0, \
+		std::pmr::memory_resource* _resource = std::pmr::get_default_resource());
 
-	auto capacity() const noexcept
+	// 通道无效则返回零
+	SizeType capacity(LANE_TYPE _lane = LANE_TYPE_BULK) const noexcept
 	{
-		return _capacity.load(std::memory_order::relaxed);
+		if (_lane >= LANE_TYPE_SIZE) return 0;
+
+		const auto& lane = _lanes[_lane];
+		return lane._capacity.load(std::memory_order::relaxed);
 	}
 
+	// 限制所有通道
 	void limit(SizeType _maxSize, SizeType _capacity) noexcept;
 
-	bool empty() const noexcept
+	// 限制指定通道，忽略无效通道
+	void limit(LANE_TYPE _lane, SizeType _capacity) noexcept
 	{
-		return _queue.empty() \
-			and _buffer.empty();
+		if (_lane >= LANE_TYPE_SIZE) return;
+
+		auto& lane = _lanes[_lane];
+		lane._capacity.store(_capacity, \
+			std::memory_order::relaxed);
 	}
 
-	bool idle() const noexcept;
+	// 通道无效则返回零
+	SizeType weight(LANE_TYPE _lane) const noexcept
+	{
+		if (_lane >= LANE_TYPE_SIZE) return 0;
+
+		const auto& lane = _lanes[_lane];
+		return lane._weight.load(std::memory_order::relaxed);
+	}
 
+	// 设置每轮调度之数据包数量，至少为一，忽略无效通道
+	void weight(LANE_TYPE _lane, SizeType _weight) noexcept
+	{
+		if (_lane >= LANE_TYPE_SIZE) return;
+
+		auto& lane = _lanes[_lane];
+		lane._weight.store(_weight > 0 ? _weight : 1, \
+			std::memory_order::relaxed);
+	}
+
+	// 信道剩余配额，未限制则返回MAX_SIZE
+	SizeType credit(ChannelType _channel) const noexcept;
+
+	// 授予信道流量配额，启用信道流量控制
+	void grant(ChannelType _channel, SizeType _credit);
+
+	// 解除信道流量控制
+	void revoke(ChannelType _channel)
+	{
+		_credits.erase(_channel);
+	}
+
+	bool empty() const noexcept;
+
+	// 拥塞时仅控制通道可放入数据包
+	bool idle(LANE_TYPE _lane = LANE_TYPE_BULK) const noexcept;
+
+	/*
+	 * 按优先级与权重交织各通道数据包：
+	 * 每轮依优先级选取尚有配额之非空通道，
+	 * 所有非空通道配额耗尽后开启新一轮。
+	 * 通道内轮询配额充足之信道，
+	 * 避免单一信道阻塞其他信道。
+	 */
 	const char* data(SizeType& _size);
 
-	bool put(const char* _data, SizeType _size);
+	bool put(const char* _data, SizeType _size, \
+		LANE_TYPE _lane = LANE_TYPE_BULK)
+	{
+		return put(0, _data, _size, _lane);
+	}
+
+	bool put(const Buffer& _buffer, \
+		LANE_TYPE _lane = LANE_TYPE_BULK)
+	{
+		return put(_buffer.data(), _buffer.size(), _lane);
+	}
+
+	// 非零信道须启用FLAG_TYPE_CHANNEL
+	bool put(ChannelType _channel, \
+		const char* _data, SizeType _size, \
+		LANE_TYPE _lane = LANE_TYPE_BULK);
 
-	bool put(const Buffer& _buffer)
+	bool put(ChannelType _channel, const Buffer& _buffer, \
+		LANE_TYPE _lane = LANE_TYPE_BULK)
 	{
-		return put(_buffer.data(), _buffer.size());
+		return put(_channel, _buffer.data(), _buffer.size(), _lane);
 	}
 
 	void take(SizeType _size);
@@ -164,28 +422,57 @@ public:
 		_offset = 0;
 	}
 
+	// 丢弃排队与暂存之数据，信道流量配额由grant与revoke管理
 	void clear() noexcept;
+
+	// 释放空闲内存
+	void trim();
 };
 
+/*
+ * 信道队列容量仅约束本端：复用信道时，队列已满之信道数据包滞留，
+ * 不阻塞其他信道之解析，亦不向对端反馈；
+ * 默认信道或有滞留数据包之信道队列已满，则idle为false以暂停接收。
+ * 对端流量配额由应用层经OutputByteStream::grant授予。
+ */
 class InputByteStream : public ByteStream
 {
 	std::atomic<SizeType> _capacity;
-	QueueType _queue;
+	ChannelQueue _queues;
+
+	// 队列已满之信道滞留数据包，至多maxSize字节
+	ChannelQueue _pending;
+	SizeType _pendingSize;
 
 	StreamSize _size, _offset;
-	Buffer _buffer;
+	ChannelType _channel;
+	AlignedBuffer _buffer;
 
 private:
 	bool getSize();
 
-	bool getPacket();
+	void getChannel();
+
+	// 校验数据包，交予_visitor或移入队列，_packets累计入队字节数
+	bool getPacket(SizeType _extraSize, bool _pending, \
+		const Visitor& _visitor, SizeType& _packets);
+
+	// 队列容量恢复之信道，移入滞留数据包
+	void promote();
 
-	bool flushBuffer();
+	bool flushBuffer(const Visitor& _visitor = nullptr);
+
+	// 信道队列容量未满
+	bool available(ChannelType _channel) const noexcept;
 
 public:
-	InputByteStream(SizeType _maxSize = 0, SizeType _capacity = 0) : \
-		ByteStream(_maxSize), _capacity(_capacity), _size(0), _offset(0) {}
+	// 接收缓冲自_resource分配
+	InputByteStream(SizeType _maxSize = 0, SizeType _capacity = 0, \
+		std::pmr::memory_resource* _resource = std::pmr::get_default_resource()) : \
+		ByteStream(_maxSize), _capacity(_capacity), _pendingSize(0), \
+		_size(0), _offset(0), _channel(0), _buffer(_resource) {}
 
+	// 每个信道之队列容量
 	auto capacity() const noexcept
 	{
 		return _capacity.load(std::memory_order::relaxed);
@@ -193,51 +480,84 @@ public:
 
 	void limit(SizeType _maxSize, SizeType _capacity) noexcept;
 
-	bool empty() const noexcept
+	bool empty() const noexcept;
+
+	bool empty(ChannelType _channel) const noexcept
 	{
-		return _queue.empty();
+		return count(_queues, _channel) <= 0;
 	}
 
 	// 先调用idle，再进行receive，最后调用put
 	bool idle() const noexcept;
 
-	bool flush()
+	/*
+	 * 取出数据包后调用，移入滞留数据包并解析缓冲剩余数据包。
+	 * 负载就地交予_visitor，起始于对齐边界，无需拷贝；
+	 * _visitor返回false或信道尚有排队数据包，则数据包入队。
+	 * _visitor内不得访问本字节流。
+	 */
+	bool flush(const Visitor& _visitor = nullptr)
 	{
-		return flushBuffer();
+		return flushBuffer(_visitor);
 	}
 
-	bool put(const char* _data, SizeType _size, SizeType& _offset);
+	bool put(const char* _data, SizeType _size, \
+		SizeType& _offset, const Visitor& _visitor = nullptr);
 
-	bool put(const Buffer& _buffer, SizeType& _offset)
+	bool put(const Buffer& _buffer, SizeType& _offset, \
+		const Visitor& _visitor = nullptr)
 	{
-		return put(_buffer.data(), _buffer.size(), _offset);
+		return put(_buffer.data(), _buffer.size(), _offset, _visitor);
 	}
 
-	bool put(const char* _data, SizeType _size);
+	bool put(const char* _data, SizeType _size, \
+		const Visitor& _visitor = nullptr);
 
-	bool put(const Buffer& _buffer)
+	bool put(const Buffer& _buffer, \
+		const Visitor& _visitor = nullptr)
 	{
-		return put(_buffer.data(), _buffer.size());
+		return put(_buffer.data(), _buffer.size(), _visitor);
 	}
 
-	bool take(Buffer& _packet) noexcept;
+	bool take(Buffer& _packet) noexcept
+	{
+		return take(0, _packet);
+	}
 
 	bool take(QueueType& _queue) noexcept
 	{
-		this->_queue.swap(_queue);
-		return not _queue.empty();
+		return take(0, _queue);
 	}
 
+	bool take(ChannelType _channel, Buffer& _packet) noexcept;
+
+	// 交换信道队列与_queue，信道无数据包则_queue保持不变
+	bool take(ChannelType _channel, QueueType& _queue) noexcept;
+
 	void reset() noexcept
 	{
+		decrease(_buffer.size());
+
 		_size = _offset = 0;
+		_channel = 0;
 		_buffer.clear();
 	}
 
 	void clear() noexcept
 	{
-		_queue.clear();
+		_queues.clear();
+		_pending.clear();
+		_pendingSize = 0;
 		reset();
+		update(0);
+	}
+
+	// 释放空闲内存
+	void trim()
+	{
+		ByteStream::trim(_queues);
+		ByteStream::trim(_pending);
+		ByteStream::trim(_buffer);
 	}
 };
 
@@ -0,0 +1,217 @@
+﻿#include "ConnectionTable.h"
+#include "SlabResource.h"
+
+#include <thread>
+#include <algorithm>
+
+ETERFREE_SPACE_BEGIN
+
+void Connection::throttle(bool _throttled) noexcept
+{
+	if (_throttled == this->_throttled) return;
+
+	// 控制通道不限流，以免拥塞时无法调度控制报文
+	for (std::size_t index = OutputByteStream::LANE_TYPE_CONTROL + 1; \
+		index < _capacities.size(); ++index)
+	{
+		auto lane = static_cast<LANE_TYPE>(index);
+		if (_throttled)
+		{
+			_capacities[index] = _output.capacity(lane);
+			_output.limit(lane, THROTTLED_CAPACITY);
+		}
+		else
+			_output.limit(lane, _capacities[index]);
+	}
+
+	// 输入队列已满则idle为false，暂停接收以限制输入内存
+	_input.limit(_maxSize, _throttled ? \
+		THROTTLED_CAPACITY : _capacity);
+	this->_throttled = _throttled;
+}
+
+void Connection::elapse(bool _active, SizeType _rounds)
+{
+	if (_active)
+	{
+		this->_rounds = 0;
+		return;
+	}
+
+	if (_rounds > 0 \
+		and ++this->_rounds == _rounds)
+		trim();
+}
+
+class ConnectionTable::Shard final
+{
+	using TableType = \
+		std::pmr::unordered_map<KeyType, Connection>;
+
+public:
+	std::mutex _mutex;
+
+	// 分片内存池，连接节点由其分配
+	std::pmr::unsynchronized_pool_resource _pool;
+
+	// 分片之收发缓冲，仅由持有分片锁之线程访问
+	SlabResource _slab;
+	TableType _table;
+
+	SizeType _usage;
+	bool _throttled;
+
+public:
+	Shard() : _table(&_pool), \
+		_usage(0), _throttled(false) {}
+};
+
+ConnectionTable::ConnectionTable(SizeType _shards, \
+	SizeType _budget) : _budget(_budget), _usage(0), _rounds(0)
+{
+	if (_shards <= 0)
+		_shards = std::thread::hardware_concurrency();
+
+	if (_shards <= 0) _shards = 1;
+
+	this->_shards.reserve(_shards);
+	for (decltype(_shards) index = 0; \
+		index < _shards; ++index)
+		this->_shards.push_back(std::make_unique<Shard>());
+}
+
+ConnectionTable::~ConnectionTable() noexcept = default;
+
+auto ConnectionTable::size() const -> SizeType
+{
+	SizeType size = 0;
+	for (const auto& shard : _shards)
+	{
+		std::lock_guard lock(shard->_mutex);
+		size += shard->_table.size();
+	}
+	return size;
+}
+
+bool ConnectionTable::insert(KeyType _key, \
+	SizeType _maxSize, SizeType _capacity)
+{
+	auto& shard = *_shards[this->shard(_key)];
+	std::lock_guard lock(shard._mutex);
+
+	auto [iterator, result] = shard._table.try_emplace(_key, \
+		_maxSize, _capacity, &shard._slab);
+	if (result and shard._throttled)
+		iterator->second.throttle(true);
+	return result;
+}
+
+bool ConnectionTable::erase(KeyType _key)
+{
+	auto& shard = *_shards[this->shard(_key)];
+	std::lock_guard lock(shard._mutex);
+
+	auto iterator = shard._table.find(_key);
+	if (iterator == shard._table.end())
+		return false;
+
+	// 立即扣除连接之占用，以免限流持续至分片下次处理
+	auto usage = std::min(iterator->second.usage(), shard._usage);
+	shard._table.erase(iterator);
+	shard._usage -= usage;
+	_usage.fetch_sub(usage, std::memory_order::relaxed);
+	return true;
+}
+
+bool ConnectionTable::find(KeyType _key, \
+	const Functor& _functor)
+{
+	auto& shard = *_shards[this->shard(_key)];
+	std::lock_guard lock(shard._mutex);
+
+	auto iterator = shard._table.find(_key);
+	if (iterator == shard._table.end())
+		return false;
+
+	if (_functor) _functor(_key, iterator->second);
+	return true;
+}
+
+void ConnectionTable::trim()
+{
+	for (auto& shard : _shards)
+	{
+		std::lock_guard lock(shard->_mutex);
+		for (auto& [key, connection] : shard->_table)
+			connection.trim();
+		shard->_slab.trim();
+	}
+}
+
+auto ConnectionTable::process(SizeType _shard, \
+	const Functor& _readable, const Functor& _writable) \
+-> SizeType
+{
+	if (_shard >= _shards.size()) return 0;
+
+	auto& shard = *_shards[_shard];
+	std::lock_guard lock(shard._mutex);
+
+	auto rounds = this->rounds();
+
+	SizeType counter = 0, usage = 0;
+	for (auto& [key, connection] : shard._table)
+	{
+		bool processed = false;
+		if (_writable \
+			and not connection.output().empty())
+		{
+			_writable(key, connection);
+			processed = true;
+		}
+
+		// 输入队列容量恢复后，解析缓冲之剩余数据包
+		auto& input = connection.input();
+		input.flush();
+
+		if (_readable and not input.empty())
+		{
+			_readable(key, connection);
+			processed = true;
+		}
+
+		if (processed) ++counter;
+		connection.elapse(processed, rounds);
+		usage += connection.usage();
+	}
+
+	/*
+	 * 连接释放之空闲块批量归还上游：超出预算或分片空闲则全部归还，
+	 * 否则每级保留一个空闲块，以免分配与归还交替。
+	 */
+	if (exceed())
+		shard._slab.trim();
+	else if (rounds > 0)
+		shard._slab.trim(counter > 0 ? 1 : 0);
+
+	// 分片内存池之空闲槽位亦计入占用
+	auto& slab = shard._slab;
+	usage += slab.usage() - slab.allocated();
+
+	// 无符号差值按模运算，可正确累加负增量
+	_usage.fetch_add(usage - shard._usage, \
+		std::memory_order::relaxed);
+	shard._usage = usage;
+
+	// 超出预算则限制队列容量，恢复后解除限制
+	if (bool throttled = exceed(); \
+		throttled != shard._throttled)
+	{
+		for (auto& [key, connection] : shard._table)
+			connection.throttle(throttled);
+		shard._throttled = throttled;
+	}
+	return counter;
+}
+
+ETERFREE_SPACE_END
@@ -0,0 +1,207 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <memory_resource>
+#include <mutex>
+#include <atomic>
+
+#include "ByteStream.h"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+// 连接：一对输出字节流与输入字节流
+class Connection final
+{
+public:
+	using SizeType = ByteStream::SizeType;
+
+private:
+	using LANE_TYPE = OutputByteStream::LANE_TYPE;
+
+	// 限流时之队列容量
+	static constexpr SizeType THROTTLED_CAPACITY = 1;
+
+private:
+	SizeType _maxSize; // 预设数据包上限
+	SizeType _capacity; // 预设队列容量
+	SizeType _rounds; // 连续空闲轮数
+
+	// 限流前各通道队列容量，解除限流时恢复
+	std::array<SizeType, OutputByteStream::LANE_TYPE_SIZE> _capacities;
+	bool _throttled;
+
+	OutputByteStream _output;
+	InputByteStream _input;
+
+public:
+	// 收发缓冲自_resource分配
+	Connection(SizeType _maxSize = 0, SizeType _capacity = 0, \
+		std::pmr::memory_resource* _resource = std::pmr::get_default_resource()) : \
+		_maxSize(_maxSize), _capacity(_capacity), _rounds(0), \
+		_capacities{}, _throttled(false), \
+		_output(_maxSize, _capacity, _resource), \
+		_input(_maxSize, _capacity, _resource) {}
+
+	Connection(const Connection&) = delete;
+
+	Connection& operator=(const Connection&) = delete;
+
+	auto capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	auto& output() noexcept
+	{
+		return _output;
+	}
+
+	const auto& output() const noexcept
+	{
+		return _output;
+	}
+
+	auto& input() noexcept
+	{
+		return _input;
+	}
+
+	const auto& input() const noexcept
+	{
+		return _input;
+	}
+
+	// 占用字节数
+	auto usage() const noexcept
+	{
+		return _output.usage() + _input.usage();
+	}
+
+	// 限制除控制通道外之队列容量，解除时恢复各通道容量
+	void throttle(bool _throttled) noexcept;
+
+	// 释放空闲内存
+	void trim()
+	{
+		_output.trim();
+		_input.trim();
+	}
+
+	// 累计空闲轮数，达到阈值则释放空闲内存
+	void elapse(bool _active, SizeType _rounds);
+};
+
+// 连接表：按键将连接分片，每个工作线程处理若干分片
+class ConnectionTable final
+{
+public:
+	using KeyType = std::uint64_t;
+	using SizeType = Connection::SizeType;
+
+	using Functor = std::function<void(KeyType, Connection&)>;
+
+private:
+	class Shard;
+
+private:
+	std::vector<std::unique_ptr<Shard>> _shards;
+
+	// 全局内存预算与当前占用
+	std::atomic<SizeType> _budget;
+	std::atomic<SizeType> _usage;
+
+	// 释放空闲内存之空闲轮数阈值
+	std::atomic<SizeType> _rounds;
+
+public:
+	// 分片数量默认为处理器核心数量
+	ConnectionTable(SizeType _shards = 0, SizeType _budget = 0);
+
+	~ConnectionTable() noexcept;
+
+	ConnectionTable(const ConnectionTable&) = delete;
+
+	ConnectionTable& operator=(const ConnectionTable&) = delete;
+
+	// 分片数量
+	auto shards() const noexcept
+	{
+		return _shards.size();
+	}
+
+	// 键所属分片
+	SizeType shard(KeyType _key) const noexcept
+	{
+		return std::hash<KeyType>{}(_key) % _shards.size();
+	}
+
+	auto budget() const noexcept
+	{
+		return _budget.load(std::memory_order::relaxed);
+	}
+
+	// 设置全局内存预算，零表示不限制
+	void budget(SizeType _budget) noexcept
+	{
+		this->_budget.store(_budget, \
+			std::memory_order::relaxed);
+	}
+
+	// 最近统计之内存占用
+	auto usage() const noexcept
+	{
+		return _usage.load(std::memory_order::relaxed);
+	}
+
+	auto rounds() const noexcept
+	{
+		return _rounds.load(std::memory_order::relaxed);
+	}
+
+	// 设置空闲轮数阈值，零表示不自动释放
+	void rounds(SizeType _rounds) noexcept
+	{
+		this->_rounds.store(_rounds, \
+			std::memory_order::relaxed);
+	}
+
+	// 超出预算
+	bool exceed() const noexcept
+	{
+		auto budget = this->budget();
+		return budget > 0 and usage() > budget;
+	}
+
+	// 连接数量
+	SizeType size() const;
+
+	bool insert(KeyType _key, \
+		SizeType _maxSize = 0, SizeType _capacity = 0);
+
+	bool erase(KeyType _key);
+
+	// 在分片锁内访问连接
+	bool find(KeyType _key, const Functor& _functor);
+
+	// 释放所有连接之空闲内存，并将分片之空闲块归还上游
+	void trim();
+
+	/*
+	 * 批量处理分片：逐个连接，输出非空则调用_writable，
+	 * 解析输入缓冲后，输入非空则调用_readable；
+	 * 连续空闲达到阈值之连接释放空闲内存，分片之空闲块批量归还上游；
+	 * 最后统计分片内存占用，依据全局预算调整队列容量。
+	 * 返回处理的连接数量。
+	 */
+	SizeType process(SizeType _shard, \
+		const Functor& _readable, const Functor& _writable);
+};
+
+ETERFREE_SPACE_END
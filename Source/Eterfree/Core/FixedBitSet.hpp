@@ -0,0 +1,426 @@
+﻿#pragma once
+
+#include <bit>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 定长位集合：位数量于编译期确定，元素存储于对象内部，无需分配堆内存。
+ * 接口与BitSet一致，所有操作可于常量表达式求值；超出位数量之位置视为零，设置无效。
+ */
+template <std::unsigned_integral _ValueType, std::size_t _BITS>
+class FixedBitSet final
+{
+	static_assert(_BITS > 0, "The number of bits is zero.");
+
+public:
+	using ValueType = _ValueType;
+	using SizeType = std::size_t;
+
+	using Iterator = BitIterator<ValueType>;
+
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	// 位数量
+	static constexpr SizeType BITS = _BITS;
+
+private:
+	// 单元素最大值
+	static constexpr ValueType MAX_ELEMENT = \
+		~static_cast<ValueType>(0);
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+	// 元素数量
+	static constexpr SizeType SIZE = (BITS + BIT_SIZE - 1) / BIT_SIZE;
+
+	// 末元素之有效掩码
+	static constexpr ValueType TAIL_MASK = BITS % BIT_SIZE == 0 ? \
+		MAX_ELEMENT : static_cast<ValueType>(MAX_ELEMENT \
+			>> (BIT_SIZE - BITS % BIT_SIZE));
+
+private:
+	std::array<ValueType, SIZE> _array; // 元素数组
+
+public:
+	friend constexpr auto operator&(const FixedBitSet& _left, \
+		const FixedBitSet& _right) noexcept
+	{
+		return FixedBitSet(_left) &= _right;
+	}
+
+	friend constexpr auto operator|(const FixedBitSet& _left, \
+		const FixedBitSet& _right) noexcept
+	{
+		return FixedBitSet(_left) |= _right;
+	}
+
+	friend constexpr auto operator^(const FixedBitSet& _left, \
+		const FixedBitSet& _right) noexcept
+	{
+		return FixedBitSet(_left) ^= _right;
+	}
+
+private:
+	// 生成单元素
+	static constexpr ValueType generate(SizeType _position) noexcept
+	{
+		return static_cast<ValueType>(1) << _position % BIT_SIZE;
+	}
+
+private:
+	// 清除末元素之无效位
+	constexpr FixedBitSet& trim() noexcept
+	{
+		_array.back() &= TAIL_MASK;
+		return *this;
+	}
+
+	// 遍历指定范围元素，首尾元素按掩码处理
+	template <typename _Operation>
+	constexpr void traverse(SizeType _begin, SizeType _end, \
+		_Operation _operation) noexcept;
+
+public:
+	constexpr FixedBitSet() noexcept : _array() {}
+
+	// 以整数初始化低位
+	constexpr FixedBitSet(std::uint64_t _value) noexcept : _array()
+	{
+		for (SizeType index = 0; index < SIZE and _value != 0; ++index)
+		{
+			_array[index] = static_cast<ValueType>(_value);
+			_value = BIT_SIZE < 64 ? _value >> BIT_SIZE % 64 : 0;
+		}
+		trim();
+	}
+
+	constexpr FixedBitSet(const ValueType* _data, SizeType _size) noexcept : \
+		_array()
+	{
+		std::copy(_data, _data + std::min(_size, SIZE), _array.begin());
+		trim();
+	}
+
+	constexpr bool operator==(const FixedBitSet&) const noexcept = default;
+
+	constexpr bool operator[](SizeType _position) const noexcept
+	{
+		return exist(_position);
+	}
+
+	constexpr FixedBitSet& operator&=(const FixedBitSet& _bitSet) noexcept
+	{
+		for (SizeType index = 0; index < SIZE; ++index)
+			_array[index] &= _bitSet._array[index];
+		return *this;
+	}
+
+	constexpr FixedBitSet& operator|=(const FixedBitSet& _bitSet) noexcept
+	{
+		for (SizeType index = 0; index < SIZE; ++index)
+			_array[index] |= _bitSet._array[index];
+		return *this;
+	}
+
+	constexpr FixedBitSet& operator^=(const FixedBitSet& _bitSet) noexcept
+	{
+		for (SizeType index = 0; index < SIZE; ++index)
+			_array[index] ^= _bitSet._array[index];
+		return *this;
+	}
+
+	constexpr auto operator~() const noexcept
+	{
+		return FixedBitSet(*this).flip();
+	}
+
+	constexpr FixedBitSet& operator<<=(SizeType _position) noexcept;
+
+	constexpr FixedBitSet& operator>>=(SizeType _position) noexcept;
+
+	constexpr auto operator<<(SizeType _position) const noexcept
+	{
+		return FixedBitSet(*this) <<= _position;
+	}
+
+	constexpr auto operator>>(SizeType _position) const noexcept
+	{
+		return FixedBitSet(*this) >>= _position;
+	}
+
+	// 存在有效位
+	constexpr bool exist(SizeType _position) const noexcept
+	{
+		return _position < BITS \
+			and (_array[_position / BIT_SIZE] & generate(_position)) != 0;
+	}
+
+	constexpr SizeType find(SizeType _position, \
+		bool _value = true) const noexcept
+	{
+		auto position = findBit(_array.data(), SIZE, _position, _value);
+		return position < BITS ? position : NPOS;
+	}
+
+	constexpr SizeType rfind(SizeType _position, \
+		bool _value = true) const noexcept
+	{
+		return rfindBit(_array.data(), \
+			std::min(_position, BITS - 1), _value);
+	}
+
+	constexpr SizeType first(bool _value = true) const noexcept
+	{
+		return find(0, _value);
+	}
+
+	constexpr SizeType last(bool _value = true) const noexcept
+	{
+		return rfind(BITS - 1, _value);
+	}
+
+	constexpr SizeType next(SizeType _position, \
+		bool _value = true) const noexcept
+	{
+		return _position < NPOS ? find(_position + 1, _value) : NPOS;
+	}
+
+	constexpr SizeType prev(SizeType _position, \
+		bool _value = true) const noexcept
+	{
+		return _position > 0 ? rfind(_position - 1, _value) : NPOS;
+	}
+
+	// 遍历有效位
+	constexpr Iterator begin() const noexcept
+	{
+		return Iterator(_array.data(), SIZE, 0);
+	}
+
+	constexpr Iterator end() const noexcept
+	{
+		return Iterator(_array.data(), SIZE, SIZE);
+	}
+
+	// 获取元素内容
+	constexpr auto data() const noexcept
+	{
+		return _array.data();
+	}
+
+	// 获取元素数量
+	static constexpr auto size() noexcept
+	{
+		return SIZE;
+	}
+
+	// 统计有效位
+	constexpr SizeType count() const noexcept
+	{
+		SizeType counter = 0;
+		for (auto element : _array)
+			counter += std::popcount(element);
+		return counter;
+	}
+
+	// 所有位有效
+	constexpr bool all() const noexcept
+	{
+		for (SizeType index = 0; index + 1 < SIZE; ++index)
+			if (_array[index] != MAX_ELEMENT) return false;
+		return _array.back() == TAIL_MASK;
+	}
+
+	// 任意位有效
+	constexpr bool any() const noexcept
+	{
+		return not none();
+	}
+
+	// 无有效位
+	constexpr bool none() const noexcept
+	{
+		for (auto element : _array)
+			if (element != 0) return false;
+		return true;
+	}
+
+	// 设置指定位
+	constexpr FixedBitSet& set(SizeType _position, \
+		bool _value = true) noexcept
+	{
+		if (not _value) return reset(_position);
+
+		if (_position < BITS)
+			_array[_position / BIT_SIZE] |= generate(_position);
+		return *this;
+	}
+
+	// 设置指定范围
+	constexpr FixedBitSet& set(SizeType _begin, SizeType _end, \
+		bool _value = true) noexcept
+	{
+		if (not _value) return reset(_begin, _end);
+
+		traverse(_begin, _end, \
+			[](ValueType& _element, ValueType _mask) noexcept
+			{ _element |= _mask; });
+		return *this;
+	}
+
+	// 设置所有位
+	constexpr FixedBitSet& set() noexcept
+	{
+		_array.fill(MAX_ELEMENT);
+		return trim();
+	}
+
+	// 重置指定位
+	constexpr FixedBitSet& reset(SizeType _position) noexcept
+	{
+		if (_position < BITS)
+			_array[_position / BIT_SIZE] &= ~generate(_position);
+		return *this;
+	}
+
+	// 重置指定范围
+	constexpr FixedBitSet& reset(SizeType _begin, SizeType _end) noexcept
+	{
+		traverse(_begin, _end, \
+			[](ValueType& _element, ValueType _mask) noexcept
+			{ _element &= ~_mask; });
+		return *this;
+	}
+
+	// 重置所有位
+	constexpr FixedBitSet& reset() noexcept
+	{
+		_array.fill(0);
+		return *this;
+	}
+
+	// 翻转指定位
+	constexpr FixedBitSet& flip(SizeType _position) noexcept
+	{
+		if (_position < BITS)
+			_array[_position / BIT_SIZE] ^= generate(_position);
+		return *this;
+	}
+
+	// 翻转指定范围
+	constexpr FixedBitSet& flip(SizeType _begin, SizeType _end) noexcept
+	{
+		traverse(_begin, _end, \
+			[](ValueType& _element, ValueType _mask) noexcept
+			{ _element ^= _mask; });
+		return *this;
+	}
+
+	// 翻转所有位
+	constexpr FixedBitSet& flip() noexcept
+	{
+		for (auto& element : _array)
+			element = ~element;
+		return trim();
+	}
+
+	// 复制指定范围，移至低位
+	constexpr FixedBitSet copy(SizeType _begin, SizeType _end) const noexcept
+	{
+		if (_begin >= _end or _begin >= BITS) return FixedBitSet();
+
+		return (*this >> _begin).reset(_end - _begin, BITS);
+	}
+};
+
+// 遍历指定范围元素
+template <std::unsigned_integral _ValueType, std::size_t _BITS>
+template <typename _Operation>
+constexpr void FixedBitSet<_ValueType, _BITS>::traverse(SizeType _begin, \
+	SizeType _end, _Operation _operation) noexcept
+{
+	_end = std::min(_end, BITS);
+	if (_begin >= _end) return;
+
+	auto begin = _begin / BIT_SIZE;
+	auto end = (_end - 1) / BIT_SIZE;
+	for (auto index = begin; index <= end; ++index)
+	{
+		auto mask = MAX_ELEMENT;
+		if (index == begin)
+			mask &= static_cast<ValueType>(MAX_ELEMENT << _begin % BIT_SIZE);
+
+		if (index == end)
+			mask &= static_cast<ValueType>(MAX_ELEMENT \
+				>> (BIT_SIZE - 1 - (_end - 1) % BIT_SIZE));
+
+		_operation(_array[index], mask);
+	}
+}
+
+template <std::unsigned_integral _ValueType, std::size_t _BITS>
+constexpr auto FixedBitSet<_ValueType, _BITS>::operator<<=(SizeType _position) noexcept \
+-> FixedBitSet&
+{
+	if (_position >= BITS) return reset();
+
+	auto offset = _position / BIT_SIZE;
+	_position %= BIT_SIZE;
+
+	for (auto index = SIZE; index > offset; --index)
+	{
+		auto cursor = index - 1 - offset;
+		auto element = static_cast<ValueType>(_array[cursor] << _position);
+
+		// 第一条件：避免未定义行为之位移计数过大
+		if (_position > 0 and cursor > 0)
+			element |= _array[cursor - 1] >> (BIT_SIZE - _position);
+
+		_array[index - 1] = element;
+	}
+
+	for (SizeType index = 0; index < offset; ++index)
+		_array[index] = 0;
+	return trim();
+}
+
+template <std::unsigned_integral _ValueType, std::size_t _BITS>
+constexpr auto FixedBitSet<_ValueType, _BITS>::operator>>=(SizeType _position) noexcept \
+-> FixedBitSet&
+{
+	if (_position >= BITS) return reset();
+
+	auto offset = _position / BIT_SIZE;
+	_position %= BIT_SIZE;
+
+	for (SizeType index = 0; index + offset < SIZE; ++index)
+	{
+		auto cursor = index + offset;
+		auto element = static_cast<ValueType>(_array[cursor] >> _position);
+
+		// 第一条件：避免未定义行为之位移计数过大
+		if (_position > 0 and cursor + 1 < SIZE)
+			element |= static_cast<ValueType>(_array[cursor + 1] \
+				<< (BIT_SIZE - _position));
+
+		_array[index] = element;
+	}
+
+	for (auto index = SIZE - offset; index < SIZE; ++index)
+		_array[index] = 0;
+	return *this;
+}
+
+ETERFREE_SPACE_END
@@ -0,0 +1,698 @@
+﻿#pragma once
+
+#include <bit>
+#include <span>
+#include <array>
+#include <tuple>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "BitSetView.hpp"
+#include "ByteStream.h"
+#include "Common.hpp"
+#include "Eterfree/Platform/Core/Endian.h"
+
+ETERFREE_SPACE_BEGIN
+
+// 数据包字段：布尔、整数、浮点数或枚举，宽度至多八字节
+template <typename _Type>
+concept PacketField = (std::is_arithmetic_v<_Type> \
+	or std::is_enum_v<_Type>) \
+	and (sizeof(_Type) == sizeof(std::uint8_t) \
+		or sizeof(_Type) == sizeof(std::uint16_t) \
+		or sizeof(_Type) == sizeof(std::uint32_t) \
+		or sizeof(_Type) == sizeof(std::uint64_t));
+
+/*
+ * 定长结构之字段列表：特化PacketLayout，按声明顺序以成员指针列举字段，
+ * 例如 static constexpr auto FIELDS = std::make_tuple(&Message::_id, &Message::_value);
+ * 字段可为PacketField、定长结构或二者之std::array。
+ */
+template <typename _Type>
+struct PacketLayout;
+
+template <typename _Type>
+concept PacketStruct = std::is_class_v<_Type> \
+	and requires { PacketLayout<_Type>::FIELDS; };
+
+// 结构之编码特性，均于编译期求值
+template <typename _Type>
+class PacketTraits
+{
+	template <typename _Member>
+	struct Member;
+
+	template <typename _Field, typename _Class>
+	struct Member<_Field _Class::*> { using Type = _Field; };
+
+	template <typename _Field>
+	struct Array : std::false_type {};
+
+	template <typename _Field, std::size_t _SIZE>
+	struct Array<std::array<_Field, _SIZE>> : std::true_type
+	{
+		using Type = _Field;
+	};
+
+	template <typename _Field>
+	static constexpr std::size_t getSize() noexcept
+	{
+		if constexpr (PacketField<_Field>)
+			return sizeof(_Field);
+		else if constexpr (PacketStruct<_Field>)
+			return PacketTraits<_Field>::SIZE;
+		else
+		{
+			static_assert(Array<_Field>::value, \
+				"The field type is not supported.");
+			using Type = typename Array<_Field>::Type;
+			return getSize<Type>() * std::tuple_size_v<_Field>;
+		}
+	}
+
+	// 布尔之线上字节未必为零或一，须逐个规范化，不可整体复制
+	template <typename _Field>
+	static constexpr bool isPacked() noexcept
+	{
+		if constexpr (PacketField<_Field>)
+			return not std::is_same_v<_Field, bool>;
+		else if constexpr (PacketStruct<_Field>)
+			return PacketTraits<_Field>::PACKED;
+		else
+			return isPacked<typename Array<_Field>::Type>();
+	}
+
+	template <typename _Tuple, std::size_t... _INDEXES>
+	static constexpr auto getSize(std::index_sequence<_INDEXES...>) noexcept
+	{
+		return (getSize<typename Member<std::tuple_element_t<_INDEXES, _Tuple>>::Type>() \
+			+ ... + 0);
+	}
+
+	template <typename _Tuple, std::size_t... _INDEXES>
+	static constexpr auto isPacked(std::index_sequence<_INDEXES...>) noexcept
+	{
+		return (isPacked<typename Member<std::tuple_element_t<_INDEXES, _Tuple>>::Type>() \
+			and ... and true);
+	}
+
+	template <typename _Field>
+	static bool isContiguous() noexcept
+	{
+		if constexpr (PacketStruct<_Field>)
+			return PacketTraits<_Field>::contiguous();
+		else if constexpr (Array<_Field>::value)
+			return isContiguous<typename Array<_Field>::Type>();
+		else
+			return true;
+	}
+
+	using Fields = std::remove_cvref_t<decltype(PacketLayout<_Type>::FIELDS)>;
+	using Indexes = std::make_index_sequence<std::tuple_size_v<Fields>>;
+
+	// 字段按序紧邻排列，运行时检测一次
+	static bool isOrdered() noexcept
+	{
+		_Type object{};
+		auto base = reinterpret_cast<const char*>(&object);
+
+		std::size_t offset = 0;
+		auto check = [&](auto _field)
+		{
+			using Field = typename Member<decltype(_field)>::Type;
+			auto address = reinterpret_cast<const char*>(&(object.*_field));
+			bool result = static_cast<std::size_t>(address - base) == offset;
+			offset += sizeof(Field);
+			return result and isContiguous<Field>();
+		};
+		return std::apply([&](auto... _fields)
+			{ return (check(_fields) and ...); }, \
+			PacketLayout<_Type>::FIELDS);
+	}
+
+public:
+	// 线上字节数
+	static constexpr std::size_t SIZE = getSize<Fields>(Indexes{});
+
+	// 内存布局可能与线上格式一致：可平凡复制且无填充
+	static constexpr bool PACKED = std::is_trivially_copyable_v<_Type> \
+		and std::is_trivially_default_constructible_v<_Type> \
+		and SIZE == sizeof(_Type) and isPacked<Fields>(Indexes{});
+
+	// 内存布局与线上格式一致，可整体复制
+	static bool contiguous() noexcept
+	{
+		if constexpr (PACKED)
+		{
+			static const bool ordered = isOrdered();
+			return ordered;
+		}
+		else
+			return false;
+	}
+};
+
+// 数据包编码：按字节序策略转换字段
+class PacketCodec
+{
+public:
+	using SizeType = ByteStream::SizeType;
+	using Buffer = ByteStream::Buffer;
+
+	// 字符串长度前缀
+	using LengthType = std::uint32_t;
+
+protected:
+	// 短数组逐元素转换，避免批量转换之调用开销
+	static constexpr SizeType BULK_SIZE = 64;
+
+protected:
+	bool _endian; // 是否转换为网络字节序
+
+protected:
+	// 批量转换字段数组，_target与_source可相同
+	static void convert(void* _target, const void* _source, \
+		SizeType _size, SizeType _width) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little)
+			Platform::byteswap(_target, _source, _size, _width);
+		else if (_target != _source)
+			std::memcpy(_target, _source, _size * _width);
+	}
+
+	template <PacketField _Type>
+	static auto encode(_Type _value, bool _endian) noexcept
+	{
+		using Type = typename Platform::Unsigned<sizeof _value>::Type;
+
+		Type value;
+		if constexpr (std::is_same_v<_Type, bool>)
+			value = _value ? 1 : 0;
+		else
+			value = std::bit_cast<Type>(_value);
+		return _endian ? Platform::convert(value) : value;
+	}
+
+	template <PacketField _Type>
+	static auto decode(typename Platform::Unsigned<sizeof(_Type)>::Type _value, \
+		bool _endian) noexcept
+	{
+		if (_endian) _value = Platform::convert(_value);
+
+		if constexpr (std::is_same_v<_Type, bool>)
+			return _value != 0;
+		else
+			return std::bit_cast<_Type>(_value);
+	}
+
+	// 逐字段写入，返回结束位置
+	template <PacketField _Type>
+	static char* store(char* _data, _Type _value, bool _endian) noexcept
+	{
+		auto value = encode(_value, _endian);
+		std::memcpy(_data, &value, sizeof value);
+		return _data + sizeof value;
+	}
+
+	template <typename _Type, std::size_t _SIZE>
+	static char* store(char* _data, \
+		const std::array<_Type, _SIZE>& _array, bool _endian) noexcept
+	{
+		if constexpr (PacketField<_Type>)
+		{
+			constexpr auto SIZE = sizeof(_Type) * _SIZE;
+			if (not _endian or sizeof(_Type) <= sizeof(std::uint8_t))
+				std::memcpy(_data, _array.data(), SIZE);
+			else if constexpr (SIZE < BULK_SIZE)
+			{
+				auto data = _data;
+				for (auto element : _array)
+					data = store(data, element, _endian);
+			}
+			else
+				convert(_data, _array.data(), _SIZE, sizeof(_Type));
+			return _data + SIZE;
+		}
+		else
+		{
+			for (const auto& element : _array)
+				_data = store(_data, element, _endian);
+			return _data;
+		}
+	}
+
+	template <PacketStruct _Type>
+	static char* store(char* _data, const _Type& _value, bool _endian) noexcept
+	{
+		return std::apply([&](auto... _fields)
+			{
+				((_data = store(_data, _value.*_fields, _endian)), ...);
+				return _data;
+			}, PacketLayout<_Type>::FIELDS);
+	}
+
+	// 逐字段读取，返回结束位置
+	template <PacketField _Type>
+	static const char* load(const char* _data, _Type& _value, bool _endian) noexcept
+	{
+		typename Platform::Unsigned<sizeof _value>::Type value;
+		std::memcpy(&value, _data, sizeof value);
+		_value = decode<_Type>(value, _endian);
+		return _data + sizeof value;
+	}
+
+	// 布尔数组逐个规范化
+	template <typename _Type, std::size_t _SIZE>
+	static const char* load(const char* _data, \
+		std::array<_Type, _SIZE>& _array, bool _endian) noexcept
+	{
+		if constexpr (PacketField<_Type> \
+			and not std::is_same_v<_Type, bool>)
+		{
+			constexpr auto SIZE = sizeof(_Type) * _SIZE;
+			if (not _endian or sizeof(_Type) <= sizeof(std::uint8_t))
+				std::memcpy(_array.data(), _data, SIZE);
+			else if constexpr (SIZE < BULK_SIZE)
+			{
+				auto data = _data;
+				for (auto& element : _array)
+					data = load(data, element, _endian);
+			}
+			else
+				convert(_array.data(), _data, _SIZE, sizeof(_Type));
+			return _data + SIZE;
+		}
+		else
+		{
+			for (auto& element : _array)
+				_data = load(_data, element, _endian);
+			return _data;
+		}
+	}
+
+	template <PacketStruct _Type>
+	static const char* load(const char* _data, _Type& _value, bool _endian) noexcept
+	{
+		return std::apply([&](auto... _fields)
+			{
+				((_data = load(_data, _value.*_fields, _endian)), ...);
+				return _data;
+			}, PacketLayout<_Type>::FIELDS);
+	}
+
+	// 线上格式与主机字节序一致
+	bool native() const noexcept
+	{
+		return not _endian or std::endian::native == std::endian::big;
+	}
+
+public:
+	PacketCodec(bool _endian) noexcept : \
+		_endian(_endian) {}
+
+	// 依字节流之FLAG_TYPE_ENDIAN选择字节序
+	PacketCodec(const ByteStream& _stream) noexcept : \
+		_endian(_stream.existFlag(ByteStream::FLAG_TYPE_ENDIAN)) {}
+
+	bool endian() const noexcept
+	{
+		return _endian;
+	}
+};
+
+/*
+ * 数据包写入器：向缓冲追加字段，预留容量后不再分配内存。
+ * 缓冲可直接交给OutputByteStream::put，清空后复用。
+ * 长度超出前缀范围则不写入并保持失败状态。
+ */
+class PacketWriter final : public PacketCodec
+{
+	Buffer& _buffer;
+	bool _good;
+
+private:
+	// 检查长度前缀可否表示
+	bool length(SizeType _size) noexcept
+	{
+		_good = _good and _size <= std::numeric_limits<LengthType>::max();
+		return _good;
+	}
+
+public:
+	PacketWriter(Buffer& _buffer, bool _endian, \
+		SizeType _capacity = 0) : \
+		PacketCodec(_endian), _buffer(_buffer), _good(true)
+	{
+		reserve(_capacity);
+	}
+
+	PacketWriter(Buffer& _buffer, const ByteStream& _stream, \
+		SizeType _capacity = 0) : \
+		PacketCodec(_stream), _buffer(_buffer), _good(true)
+	{
+		reserve(_capacity);
+	}
+
+	bool good() const noexcept
+	{
+		return _good;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return _good;
+	}
+
+	auto size() const noexcept
+	{
+		return _buffer.size();
+	}
+
+	auto& buffer() noexcept
+	{
+		return _buffer;
+	}
+
+	const auto& buffer() const noexcept
+	{
+		return _buffer;
+	}
+
+	// 预留额外容量
+	void reserve(SizeType _size)
+	{
+		_buffer.reserve(_buffer.size() + _size);
+	}
+
+	void clear() noexcept
+	{
+		_buffer.clear();
+		_good = true;
+	}
+
+	template <PacketField _Type>
+	PacketWriter& write(_Type _value)
+	{
+		auto value = encode(_value, _endian);
+		_buffer.append(reinterpret_cast<const char*>(&value), \
+			sizeof value);
+		return *this;
+	}
+
+	// 原始字节
+	PacketWriter& write(const void* _data, SizeType _size)
+	{
+		_buffer.append(static_cast<const char*>(_data), _size);
+		return *this;
+	}
+
+	// 长度前缀字符串
+	PacketWriter& write(std::string_view _string)
+	{
+		if (not length(_string.size())) return *this;
+
+		write(static_cast<LengthType>(_string.size()));
+		return write(_string.data(), _string.size());
+	}
+
+	PacketWriter& write(const char* _string)
+	{
+		return write(std::string_view(_string));
+	}
+
+	// 字段数组，不含长度前缀
+	template <PacketField _Type, std::size_t _Extent>
+	PacketWriter& write(std::span<_Type, _Extent> _array)
+	{
+		auto offset = _buffer.size();
+		write(_array.data(), _array.size_bytes());
+
+		if (_endian and sizeof(_Type) > sizeof(std::uint8_t))
+		{
+			auto data = _buffer.data() + offset;
+			convert(data, data, _array.size(), sizeof(_Type));
+		}
+		return *this;
+	}
+
+	// 位集合：元素数量前缀与元素数组，字节序不一致方转换
+	template <typename _ElementType>
+	PacketWriter& write(BitSetView<_ElementType> _view)
+	{
+		if (not length(_view.size())) return *this;
+
+		write(static_cast<LengthType>(_view.size()));
+		return write(std::span(_view.data(), _view.size()));
+	}
+
+	template <std::unsigned_integral _ValueType>
+	PacketWriter& write(const BitSet<_ValueType>& _bitSet)
+	{
+		return write(BitSetView(_bitSet));
+	}
+
+	/*
+	 * 定长结构：内存布局与线上格式一致则整体复制，
+	 * 否则展开为逐字段转换，仅扩展缓冲一次。
+	 */
+	template <PacketStruct _Type>
+	PacketWriter& write(const _Type& _value)
+	{
+		using Traits = PacketTraits<_Type>;
+
+		if (native() and Traits::contiguous())
+			return write(&_value, Traits::SIZE);
+
+		auto offset = _buffer.size();
+		_buffer.resize(offset + Traits::SIZE);
+		store(_buffer.data() + offset, _value, _endian);
+		return *this;
+	}
+
+	template <typename _Type>
+	PacketWriter& operator<<(const _Type& _value)
+	{
+		return write(_value);
+	}
+};
+
+/*
+ * 数据包读取器：就地解析接收的数据包，不复制不分配。
+ * 越界后保持失败状态，其后读取均失败，仅需最终检查一次。
+ */
+class PacketReader final : public PacketCodec
+{
+	const char* _data;
+	SizeType _size;
+	SizeType _offset;
+	bool _good;
+
+private:
+	// 剩余字节足够则前移游标，返回原偏移
+	bool advance(SizeType _size, SizeType& _offset) noexcept
+	{
+		_offset = this->_offset;
+		_good = _good & (_size <= this->_size - _offset);
+		this->_offset += _good ? _size : 0;
+		return _good;
+	}
+
+public:
+	PacketReader(std::string_view _packet, bool _endian) noexcept : \
+		PacketCodec(_endian), _data(_packet.data()), \
+		_size(_packet.size()), _offset(0), _good(true) {}
+
+	PacketReader(std::string_view _packet, \
+		const ByteStream& _stream) noexcept : \
+		PacketCodec(_stream), _data(_packet.data()), \
+		_size(_packet.size()), _offset(0), _good(true) {}
+
+	bool good() const noexcept
+	{
+		return _good;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return _good;
+	}
+
+	auto offset() const noexcept
+	{
+		return _offset;
+	}
+
+	// 剩余字节数
+	auto remain() const noexcept
+	{
+		return _size - _offset;
+	}
+
+	// 全部读取且未越界
+	bool done() const noexcept
+	{
+		return _good and _offset == _size;
+	}
+
+	template <PacketField _Type>
+	bool read(_Type& _value) noexcept
+	{
+		using Type = typename Platform::Unsigned<sizeof _value>::Type;
+
+		SizeType offset;
+		if (not advance(sizeof _value, offset)) return false;
+
+		Type value;
+		std::memcpy(&value, _data + offset, sizeof value);
+		_value = decode<_Type>(value, _endian);
+		return true;
+	}
+
+	// 失败返回默认值
+	template <PacketField _Type>
+	_Type read() noexcept
+	{
+		_Type value{};
+		read(value);
+		return value;
+	}
+
+	bool read(void* _data, SizeType _size) noexcept
+	{
+		SizeType offset;
+		if (not advance(_size, offset)) return false;
+
+		std::memcpy(_data, this->_data + offset, _size);
+		return true;
+	}
+
+	// 视图指向数据包，生命周期不超过数据包
+	bool read(std::string_view& _string) noexcept
+	{
+		LengthType size = 0;
+		if (not read(size)) return false;
+
+		SizeType offset;
+		if (not advance(size, offset)) return false;
+
+		_string = std::string_view(_data + offset, size);
+		return true;
+	}
+
+	bool read(std::string& _string)
+	{
+		std::string_view string;
+		if (not read(string)) return false;
+
+		_string.assign(string);
+		return true;
+	}
+
+	// 读取与数组等长之字段
+	template <PacketField _Type, std::size_t _Extent>
+	bool read(std::span<_Type, _Extent> _array) noexcept
+	{
+		SizeType offset;
+		if (not advance(_array.size_bytes(), offset)) return false;
+
+		if constexpr (std::is_same_v<std::remove_cv_t<_Type>, bool>)
+		{
+			// 线上字节非零即真，不可直接复制
+			for (SizeType index = 0; index < _array.size(); ++index)
+				_array[index] = _data[offset + index] != 0;
+		}
+		else if (_endian and sizeof(_Type) > sizeof(std::uint8_t))
+			convert(_array.data(), _data + offset, \
+				_array.size(), sizeof(_Type));
+		else
+			std::memcpy(_array.data(), _data + offset, \
+				_array.size_bytes());
+		return true;
+	}
+
+	// 位集合：先校验剩余字节，再改变元素数量
+	template <std::unsigned_integral _ValueType>
+	bool read(BitSet<_ValueType>& _bitSet)
+	{
+		LengthType size = 0;
+		if (not read(size)) return false;
+
+		if (size > remain() / sizeof(_ValueType))
+		{
+			_good = false;
+			return false;
+		}
+
+		_bitSet.resize(size, true);
+		return read(std::span(_bitSet.data(), _bitSet.size()));
+	}
+
+	// 读取至视图之元素，元素数量不足则失败，多余元素清零
+	template <std::unsigned_integral _ValueType>
+	bool read(BitSetView<_ValueType> _view) noexcept
+	{
+		LengthType size = 0;
+		if (not read(size)) return false;
+
+		if (size > _view.size())
+		{
+			_good = false;
+			return false;
+		}
+
+		if (not read(std::span(_view.data(), size))) return false;
+
+		_view.reset(size * _view.BIT_SIZE, _view.capacity());
+		return true;
+	}
+
+	template <PacketStruct _Type>
+	bool read(_Type& _value) noexcept
+	{
+		using Traits = PacketTraits<_Type>;
+
+		SizeType offset;
+		if (not advance(Traits::SIZE, offset)) return false;
+
+		if (native() and Traits::contiguous())
+			std::memcpy(&_value, _data + offset, Traits::SIZE);
+		else
+			load(_data + offset, _value, _endian);
+		return true;
+	}
+
+	bool skip(SizeType _size) noexcept
+	{
+		SizeType offset;
+		return advance(_size, offset);
+	}
+
+	template <typename _Type>
+	PacketReader& operator>>(_Type& _value)
+	{
+		read(_value);
+		return *this;
+	}
+
+	template <PacketField _Type, std::size_t _Extent>
+	PacketReader& operator>>(std::span<_Type, _Extent> _array) noexcept
+	{
+		read(_array);
+		return *this;
+	}
+
+	template <std::unsigned_integral _ValueType>
+	PacketReader& operator>>(BitSetView<_ValueType> _view) noexcept
+	{
+		read(_view);
+		return *this;
+	}
+};
+
+ETERFREE_SPACE_END
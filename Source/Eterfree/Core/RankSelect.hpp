@@ -0,0 +1,296 @@
+﻿#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <vector>
+
+#include "BitSetView.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 秩与选择索引：建于位集合之上，不修改位集合。
+ * 每超块六万五千五百三十六位记录一个六十四位累计计数，每块五百一十二位记录一个十六位超块内计数，
+ * 每八千一百九十二个有效位采样一次所在块，额外空间约为位数量之百分之三点二，另加采样。
+ * 秩查询为常数时间，选择查询于相邻采样之间二分查找块。
+ * 位集合修改后以update增量重建；改变元素数量或移动后须以build重建。
+ */
+template <std::unsigned_integral _ValueType>
+class RankSelect final
+{
+public:
+	using ValueType = _ValueType;
+	using SizeType = std::size_t;
+	using View = BitSetView<const ValueType>;
+
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	// 块之位数量
+	static constexpr SizeType BLOCK_BITS = 512;
+
+	// 超块之位数量
+	static constexpr SizeType SUPER_BITS = 65536;
+
+	// 选择采样间隔之有效位数量
+	static constexpr SizeType SAMPLE_SIZE = 8192;
+
+private:
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+	// 块之元素数量
+	static constexpr SizeType BLOCK_SIZE = BLOCK_BITS / BIT_SIZE;
+
+	// 超块之块数量
+	static constexpr SizeType SUPER_SIZE = SUPER_BITS / BLOCK_BITS;
+
+	static_assert(BLOCK_BITS % BIT_SIZE == 0, \
+		"The block size must be a multiple of the element size.");
+
+private:
+	View _view;
+	SizeType _count; // 有效位数量
+
+	std::vector<std::uint64_t> _supers; // 超块之前累计计数，末项为总数
+	std::vector<std::uint16_t> _blocks; // 块之前超块内计数
+	std::vector<SizeType> _samples; // 采样位所在块
+
+private:
+	// 块之前累计计数
+	SizeType base(SizeType _block) const noexcept
+	{
+		return _supers[_block / SUPER_SIZE] + _blocks[_block];
+	}
+
+	// 块内有效位数量
+	SizeType count(SizeType _block) const noexcept
+	{
+		auto begin = _block * BLOCK_SIZE;
+		auto end = std::min(begin + BLOCK_SIZE, _view.size());
+
+		SizeType counter = 0;
+		for (auto data = _view.data(); begin < end; ++begin)
+			counter += std::popcount(data[begin]);
+		return counter;
+	}
+
+	// 元素内第_rank个有效位，逐字节跳过
+	static SizeType locate(ValueType _element, SizeType _rank) noexcept;
+
+	// 自指定块起重新计算计数
+	void refresh(SizeType _begin, SizeType _end) noexcept;
+
+	// 自指定块起重新采样
+	void sample(SizeType _block);
+
+public:
+	RankSelect() noexcept : _count(0) {}
+
+	explicit RankSelect(View _view) : _count(0)
+	{
+		build(_view);
+	}
+
+	// 位数量
+	auto capacity() const noexcept
+	{
+		return _view.capacity();
+	}
+
+	// 有效位数量
+	auto count() const noexcept
+	{
+		return _count;
+	}
+
+	// 索引占用字节数
+	SizeType usage() const noexcept
+	{
+		return sizeof(std::uint64_t) * _supers.capacity() \
+			+ sizeof(std::uint16_t) * _blocks.capacity() \
+			+ sizeof(SizeType) * _samples.capacity();
+	}
+
+	// 完整重建
+	void build(View _view);
+
+	// 位范围[_begin, _end)修改后增量重建，仅重新统计修改所在块至其超块末尾
+	void update(SizeType _begin, SizeType _end);
+
+	void update(SizeType _position)
+	{
+		update(_position, _position + 1);
+	}
+
+	// 位置小于_position之指定值位数量
+	SizeType rank(SizeType _position, bool _value = true) const noexcept;
+
+	// 第_rank个有效位之位置，自零计数，不存在则返回NPOS
+	SizeType select(SizeType _rank) const noexcept;
+};
+
+// 元素内第_rank个有效位
+template <std::unsigned_integral _ValueType>
+auto RankSelect<_ValueType>::locate(ValueType _element, \
+	SizeType _rank) noexcept -> SizeType
+{
+	SizeType offset = 0;
+	if constexpr (BIT_SIZE > CHAR_BIT)
+	{
+		for (;; offset += CHAR_BIT)
+		{
+			auto byte = static_cast<std::uint8_t>(_element >> offset);
+			auto counter = static_cast<SizeType>(std::popcount(byte));
+			if (_rank < counter) break;
+			_rank -= counter;
+		}
+		_element = static_cast<ValueType>(_element >> offset);
+	}
+
+	for (; _rank > 0; --_rank)
+		_element &= static_cast<ValueType>(_element - 1);
+	return offset + std::countr_zero(_element);
+}
+
+// 重新计算块[_begin, _end)所在超块之计数，其后超块整体平移
+template <std::unsigned_integral _ValueType>
+void RankSelect<_ValueType>::refresh(SizeType _begin, SizeType _end) noexcept
+{
+	auto first = _begin / SUPER_SIZE;
+	auto last = (_end - 1) / SUPER_SIZE;
+
+	auto previous = _supers[last + 1];
+	for (auto super = first; super <= last; ++super)
+	{
+		auto begin = super == first ? _begin : super * SUPER_SIZE;
+		auto end = std::min((super + 1) * SUPER_SIZE, _blocks.size());
+
+		SizeType counter = begin % SUPER_SIZE > 0 ? _blocks[begin] : 0;
+		for (auto block = begin; block < end; ++block)
+		{
+			_blocks[block] = static_cast<std::uint16_t>(counter);
+			counter += count(block);
+		}
+		_supers[super + 1] = _supers[super] + counter;
+	}
+
+	// 其后超块之计数整体平移
+	auto difference = _supers[last + 1] - previous;
+	for (auto super = last + 2; super < _supers.size(); ++super)
+		_supers[super] += difference;
+	_count = _supers.back();
+}
+
+// 自指定块起重新采样
+template <std::unsigned_integral _ValueType>
+void RankSelect<_ValueType>::sample(SizeType _block)
+{
+	// 位于此块之前之采样不变
+	auto index = (base(_block) + SAMPLE_SIZE - 1) / SAMPLE_SIZE;
+	_samples.resize(index);
+
+	for (auto block = _block; block < _blocks.size(); ++block)
+	{
+		auto end = block + 1 < _blocks.size() ? \
+			base(block + 1) : _count;
+		for (; index * SAMPLE_SIZE < end; ++index)
+			_samples.push_back(block);
+	}
+}
+
+// 完整重建
+template <std::unsigned_integral _ValueType>
+void RankSelect<_ValueType>::build(View _view)
+{
+	this->_view = _view;
+
+	auto blocks = (_view.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	auto supers = (blocks + SUPER_SIZE - 1) / SUPER_SIZE;
+
+	_supers.assign(supers + 1, 0);
+	_blocks.assign(blocks, 0);
+	_samples.clear();
+	_count = 0;
+
+	if (blocks > 0)
+	{
+		refresh(0, blocks);
+		sample(0);
+	}
+}
+
+// 增量重建
+template <std::unsigned_integral _ValueType>
+void RankSelect<_ValueType>::update(SizeType _begin, SizeType _end)
+{
+	_end = std::min(_end, capacity());
+	if (_begin >= _end) return;
+
+	auto begin = _begin / BLOCK_BITS;
+	refresh(begin, (_end - 1) / BLOCK_BITS + 1);
+	sample(begin);
+}
+
+// 位置小于_position之指定值位数量
+template <std::unsigned_integral _ValueType>
+auto RankSelect<_ValueType>::rank(SizeType _position, \
+	bool _value) const noexcept -> SizeType
+{
+	if (_position >= capacity())
+		return _value ? _count : _position - _count;
+
+	auto block = _position / BLOCK_BITS;
+	auto counter = base(block);
+
+	auto data = _view.data();
+	auto index = _position / BIT_SIZE;
+	for (auto cursor = block * BLOCK_SIZE; cursor < index; ++cursor)
+		counter += std::popcount(data[cursor]);
+
+	if (auto offset = _position % BIT_SIZE; offset > 0)
+	{
+		auto mask = static_cast<ValueType>(~static_cast<ValueType>(0) \
+			>> (BIT_SIZE - offset));
+		counter += std::popcount(static_cast<ValueType>(data[index] & mask));
+	}
+	return _value ? counter : _position - counter;
+}
+
+// 第_rank个有效位之位置
+template <std::unsigned_integral _ValueType>
+auto RankSelect<_ValueType>::select(SizeType _rank) const noexcept \
+-> SizeType
+{
+	if (_rank >= _count) return NPOS;
+
+	// 于相邻采样之间二分查找末个累计计数不大于_rank之块
+	auto index = _rank / SAMPLE_SIZE;
+	auto low = _samples[index];
+	auto high = index + 1 < _samples.size() ? \
+		_samples[index + 1] : _blocks.size() - 1;
+	while (low < high)
+	{
+		auto middle = low + (high - low + 1) / 2;
+		if (base(middle) <= _rank) low = middle;
+		else high = middle - 1;
+	}
+
+	_rank -= base(low);
+
+	auto data = _view.data();
+	for (auto cursor = low * BLOCK_SIZE;; ++cursor)
+	{
+		auto counter = static_cast<SizeType>(std::popcount(data[cursor]));
+		if (_rank < counter)
+			return cursor * BIT_SIZE + locate(data[cursor], _rank);
+		_rank -= counter;
+	}
+}
+
+ETERFREE_SPACE_END
@@ -0,0 +1,543 @@
+﻿#include "RoaringBitSet.h"
+#include "BitKernel.h"
+
+#include <bit>
+#include <utility>
+#include <algorithm>
+
+ETERFREE_SPACE_BEGIN
+
+// 自位图构造容器，统计基数并按需转换为数组
+auto RoaringBitSet::Container::make(Bitmap&& _bitmap) -> Container
+{
+	Container container;
+	container._size = countBit(_bitmap.data(), \
+		sizeof _bitmap[0] * _bitmap.size());
+	container._data = std::move(_bitmap);
+	container.shrink();
+	return container;
+}
+
+// 转换为位图
+auto RoaringBitSet::Container::bitmap() const -> Bitmap
+{
+	if (auto bitmap = std::get_if<Bitmap>(&_data))
+		return *bitmap;
+
+	Bitmap bitmap(BITMAP_SIZE, 0);
+	if (auto array = std::get_if<Array>(&_data))
+	{
+		for (auto low : *array)
+			bitmap[low >> 6] |= std::uint64_t(1) << (low & 63);
+		return bitmap;
+	}
+
+	// 游程按字填充
+	for (const auto& run : std::get<Runs>(_data))
+	{
+		SizeType low = run._begin;
+		while (low <= run._last)
+		{
+			auto offset = low & 63;
+			auto size = std::min<SizeType>(64 - offset, run._last - low + 1);
+			auto mask = size < 64 ? (std::uint64_t(1) << size) - 1 : ~std::uint64_t(0);
+			bitmap[low >> 6] |= mask << offset;
+			low += size;
+		}
+	}
+	return bitmap;
+}
+
+// 位图基数不超过数组上限则转换为数组
+void RoaringBitSet::Container::shrink()
+{
+	auto bitmap = std::get_if<Bitmap>(&_data);
+	if (bitmap == nullptr or _size > ARRAY_SIZE) return;
+
+	Array array;
+	array.reserve(_size);
+
+	BitIterator<std::uint64_t> iterator(bitmap->data(), BITMAP_SIZE, 0);
+	BitIterator<std::uint64_t> end(bitmap->data(), BITMAP_SIZE, BITMAP_SIZE);
+	for (; iterator != end; ++iterator)
+		array.push_back(static_cast<LowType>(*iterator));
+	_data = std::move(array);
+}
+
+// 游程转换为数组或位图
+void RoaringBitSet::Container::normalize()
+{
+	auto runs = std::get_if<Runs>(&_data);
+	if (runs == nullptr) return;
+
+	if (_size > ARRAY_SIZE)
+	{
+		_data = bitmap();
+		return;
+	}
+
+	Array array;
+	array.reserve(_size);
+	for (const auto& run : *runs)
+		for (SizeType low = run._begin; low <= run._last; ++low)
+			array.push_back(static_cast<LowType>(low));
+	_data = std::move(array);
+}
+
+template <RoaringBitSet::OPERATION_TYPE _OPERATION>
+auto RoaringBitSet::Container::apply(const Container& _left, \
+	const Container& _right) -> Container
+{
+	auto left = std::get_if<Array>(&_left._data);
+	auto right = std::get_if<Array>(&_right._data);
+
+	if constexpr (_OPERATION == OPERATION_AND)
+	{
+		if (left != nullptr or right != nullptr)
+		{
+			// 以较小数组探测另一容器
+			if (left == nullptr \
+				or (right != nullptr and right->size() < left->size()))
+				return apply<_OPERATION>(_right, _left);
+
+			Container container;
+			Array array(left->size());
+			SizeType size = 0;
+
+			auto bitmap = std::get_if<Bitmap>(&_right._data);
+			if (bitmap == nullptr and left->size() < PROBE_SIZE)
+			{
+				// 小数组逐个二分探测
+				for (auto low : *left)
+					if (_right.exist(low)) array[size++] = low;
+			}
+			else
+			{
+				// 另一容器转换为位图，无分支筛选
+				Bitmap words;
+				if (bitmap == nullptr)
+				{
+					words = _right.bitmap();
+					bitmap = &words;
+				}
+
+				for (auto low : *left)
+				{
+					array[size] = low;
+					size += (*bitmap)[low >> 6] >> (low & 63) & 1;
+				}
+			}
+
+			array.resize(size);
+			container._size = size;
+			container._data = std::move(array);
+			return container;
+		}
+	}
+
+	// 数组与数组：有序合并
+	if (left != nullptr and right != nullptr)
+	{
+		Container container;
+		Array array;
+		array.reserve(left->size() + right->size());
+		if constexpr (_OPERATION == OPERATION_OR)
+			std::set_union(left->begin(), left->end(), \
+				right->begin(), right->end(), std::back_inserter(array));
+		else
+			std::set_symmetric_difference(left->begin(), left->end(), \
+				right->begin(), right->end(), std::back_inserter(array));
+
+		container._size = array.size();
+		container._data = std::move(array);
+		if (container._size > ARRAY_SIZE)
+			container._data = container.bitmap();
+		return container;
+	}
+
+	// 其他组合：按位图逐字运算
+	auto bitmap = _left.bitmap();
+	if (right != nullptr)
+	{
+		for (auto low : *right)
+		{
+			auto& word = bitmap[low >> 6];
+			auto bit = std::uint64_t(1) << (low & 63);
+			if constexpr (_OPERATION == OPERATION_OR) word |= bit;
+			else word ^= bit;
+		}
+		return make(std::move(bitmap));
+	}
+
+	auto other = _right.bitmap();
+	auto size = sizeof bitmap[0] * bitmap.size();
+	if constexpr (_OPERATION == OPERATION_AND)
+		andBit(bitmap.data(), other.data(), size);
+	else if constexpr (_OPERATION == OPERATION_OR)
+		orBit(bitmap.data(), other.data(), size);
+	else
+		xorBit(bitmap.data(), other.data(), size);
+	return make(std::move(bitmap));
+}
+
+bool RoaringBitSet::Container::operator==(const Container& _container) const
+{
+	if (_size != _container._size) return false;
+
+	if (_data.index() == _container._data.index())
+	{
+		if (auto array = std::get_if<Array>(&_data))
+			return *array == std::get<Array>(_container._data);
+
+		if (auto bitmap = std::get_if<Bitmap>(&_data))
+			return *bitmap == std::get<Bitmap>(_container._data);
+	}
+	return bitmap() == _container.bitmap();
+}
+
+// 内存占用字节数
+auto RoaringBitSet::Container::usage() const noexcept -> SizeType
+{
+	return std::visit([](const auto& _data)
+		{ return sizeof _data[0] * _data.capacity(); }, _data);
+}
+
+bool RoaringBitSet::Container::exist(LowType _low) const noexcept
+{
+	if (auto array = std::get_if<Array>(&_data))
+		return std::binary_search(array->begin(), array->end(), _low);
+
+	if (auto bitmap = std::get_if<Bitmap>(&_data))
+		return ((*bitmap)[_low >> 6] >> (_low & 63) & 1) != 0;
+
+	// 首个起点大于_low之前一游程
+	const auto& runs = std::get<Runs>(_data);
+	auto iterator = std::upper_bound(runs.begin(), runs.end(), _low, \
+		[](LowType _low, const Run& _run) { return _low < _run._begin; });
+	return iterator != runs.begin() and _low <= (--iterator)->_last;
+}
+
+// 查找首个有效位
+auto RoaringBitSet::Container::find(SizeType _low, \
+	SizeType& _cursor) const noexcept -> SizeType
+{
+	if (_low >= CHUNK_SIZE) return CHUNK_SIZE;
+
+	if (auto bitmap = std::get_if<Bitmap>(&_data))
+		return findBit(bitmap->data(), BITMAP_SIZE, _low, true);
+
+	if (auto array = std::get_if<Array>(&_data))
+	{
+		auto size = array->size();
+
+		// 提示失效则自头查找
+		if (_cursor > size or (_cursor > 0 and (*array)[_cursor - 1] >= _low))
+			_cursor = 0;
+
+		// 顺序遍历时游标即为结果
+		if (_cursor >= size or (*array)[_cursor] < _low)
+		{
+			auto iterator = std::lower_bound(array->begin() + _cursor, \
+				array->end(), _low);
+			_cursor = iterator - array->begin();
+		}
+		return _cursor < size ? (*array)[_cursor] : CHUNK_SIZE;
+	}
+
+	const auto& runs = std::get<Runs>(_data);
+	auto size = runs.size();
+	if (_cursor > size or (_cursor > 0 and runs[_cursor - 1]._last >= _low))
+		_cursor = 0;
+
+	auto iterator = std::lower_bound(runs.begin() + _cursor, runs.end(), _low, \
+		[](const Run& _run, SizeType _low) { return _run._last < _low; });
+	_cursor = iterator - runs.begin();
+	if (_cursor >= size) return CHUNK_SIZE;
+	return std::max<SizeType>(_low, runs[_cursor]._begin);
+}
+
+void RoaringBitSet::Container::set(LowType _low)
+{
+	normalize();
+
+	if (auto bitmap = std::get_if<Bitmap>(&_data))
+	{
+		auto& word = (*bitmap)[_low >> 6];
+		auto bit = std::uint64_t(1) << (_low & 63);
+		if ((word & bit) == 0)
+		{
+			word |= bit;
+			++_size;
+		}
+		return;
+	}
+
+	auto& array = std::get<Array>(_data);
+
+	// 顺序插入时追加于末尾
+	auto iterator = array.empty() or array.back() < _low ? array.end() \
+		: std::lower_bound(array.begin(), array.end(), _low);
+	if (iterator != array.end() and *iterator == _low) return;
+
+	array.insert(iterator, _low);
+	if (++_size > ARRAY_SIZE) _data = bitmap();
+}
+
+void RoaringBitSet::Container::reset(LowType _low)
+{
+	if (not exist(_low)) return;
+
+	normalize();
+
+	if (auto bitmap = std::get_if<Bitmap>(&_data))
+	{
+		(*bitmap)[_low >> 6] &= ~(std::uint64_t(1) << (_low & 63));
+		--_size;
+		shrink();
+		return;
+	}
+
+	auto& array = std::get<Array>(_data);
+	array.erase(std::lower_bound(array.begin(), array.end(), _low));
+	--_size;
+}
+
+// 游程数量较少则转换为游程
+void RoaringBitSet::Container::optimize()
+{
+	if (std::holds_alternative<Runs>(_data)) return;
+
+	Runs runs;
+	SizeType cursor = 0;
+	for (auto low = find(0, cursor); low < CHUNK_SIZE; )
+	{
+		// 查找游程终点：首个零位
+		auto last = low;
+		if (auto bitmap = std::get_if<Bitmap>(&_data))
+		{
+			auto end = findBit(bitmap->data(), BITMAP_SIZE, low, false);
+			last = end - 1;
+		}
+		else
+		{
+			const auto& array = std::get<Array>(_data);
+			while (cursor + 1 < array.size() and array[cursor + 1] == last + 1)
+			{
+				++cursor;
+				++last;
+			}
+		}
+
+		runs.push_back({ static_cast<LowType>(low), static_cast<LowType>(last) });
+		low = find(last + 1, cursor);
+	}
+
+	if (sizeof(Run) * runs.size() < usage())
+	{
+		runs.shrink_to_fit();
+		_data = std::move(runs);
+	}
+}
+
+template <RoaringBitSet::OPERATION_TYPE _OPERATION>
+RoaringBitSet RoaringBitSet::apply(const RoaringBitSet& _left, \
+	const RoaringBitSet& _right)
+{
+	const auto& left = _left._chunks;
+	const auto& right = _right._chunks;
+
+	RoaringBitSet bitSet;
+	auto& chunks = bitSet._chunks;
+	if constexpr (_OPERATION == OPERATION_AND)
+		chunks.reserve(std::min(left.size(), right.size()));
+	else
+		chunks.reserve(left.size() + right.size());
+
+	SizeType leftIndex = 0, rightIndex = 0;
+	while (leftIndex < left.size() and rightIndex < right.size())
+	{
+		const auto& leftChunk = left[leftIndex];
+		const auto& rightChunk = right[rightIndex];
+		if (leftChunk._key < rightChunk._key)
+		{
+			if constexpr (_OPERATION != OPERATION_AND)
+				chunks.push_back(leftChunk);
+			++leftIndex;
+		}
+		else if (rightChunk._key < leftChunk._key)
+		{
+			if constexpr (_OPERATION != OPERATION_AND)
+				chunks.push_back(rightChunk);
+			++rightIndex;
+		}
+		else
+		{
+			auto container = Container::apply<_OPERATION>( \
+				leftChunk._container, rightChunk._container);
+			if (container.size() > 0)
+				chunks.push_back({ leftChunk._key, std::move(container) });
+			++leftIndex;
+			++rightIndex;
+		}
+	}
+
+	if constexpr (_OPERATION != OPERATION_AND)
+	{
+		chunks.insert(chunks.end(), left.begin() + leftIndex, left.end());
+		chunks.insert(chunks.end(), right.begin() + rightIndex, right.end());
+	}
+	return bitSet;
+}
+
+// 查找键所属块之容器
+auto RoaringBitSet::container(KeyType _key) const noexcept -> const Container*
+{
+	auto iterator = std::lower_bound(_chunks.begin(), _chunks.end(), _key, less);
+	if (iterator == _chunks.end() or iterator->_key != _key) return nullptr;
+	return &iterator->_container;
+}
+
+RoaringBitSet operator&(const RoaringBitSet& _left, \
+	const RoaringBitSet& _right)
+{
+	return RoaringBitSet::apply<RoaringBitSet::OPERATION_AND>(_left, _right);
+}
+
+RoaringBitSet operator|(const RoaringBitSet& _left, \
+	const RoaringBitSet& _right)
+{
+	return RoaringBitSet::apply<RoaringBitSet::OPERATION_OR>(_left, _right);
+}
+
+RoaringBitSet operator^(const RoaringBitSet& _left, \
+	const RoaringBitSet& _right)
+{
+	return RoaringBitSet::apply<RoaringBitSet::OPERATION_XOR>(_left, _right);
+}
+
+bool RoaringBitSet::operator==(const RoaringBitSet& _bitSet) const
+{
+	if (_chunks.size() != _bitSet._chunks.size()) return false;
+
+	for (SizeType index = 0; index < _chunks.size(); ++index)
+	{
+		const auto& left = _chunks[index];
+		const auto& right = _bitSet._chunks[index];
+		if (left._key != right._key \
+			or not (left._container == right._container))
+			return false;
+	}
+	return true;
+}
+
+// 存在有效位
+bool RoaringBitSet::exist(SizeType _position) const noexcept
+{
+	if (_position > MAX_POSITION) return false;
+
+	auto container = this->container(key(_position));
+	return container != nullptr and container->exist(low(_position));
+}
+
+// 内存占用字节数
+auto RoaringBitSet::usage() const noexcept -> SizeType
+{
+	auto usage = sizeof(Chunk) * _chunks.capacity();
+	for (const auto& chunk : _chunks)
+		usage += chunk._container.usage();
+	return usage;
+}
+
+// 统计有效位
+auto RoaringBitSet::count() const noexcept -> SizeType
+{
+	SizeType counter = 0;
+	for (const auto& chunk : _chunks)
+		counter += chunk._container.size();
+	return counter;
+}
+
+// 设置指定位
+auto RoaringBitSet::set(SizeType _position, bool _value) -> RoaringBitSet&
+{
+	if (not _value) return reset(_position);
+
+	if (_position > MAX_POSITION) return *this;
+
+	auto key = this->key(_position);
+
+	// 顺序设置时追加于末尾
+	auto iterator = _chunks.empty() or _chunks.back()._key < key \
+		? _chunks.end() : std::lower_bound(_chunks.begin(), _chunks.end(), key, less);
+	if (iterator == _chunks.end() or iterator->_key != key)
+		iterator = _chunks.insert(iterator, { key, Container() });
+
+	iterator->_container.set(low(_position));
+	return *this;
+}
+
+auto RoaringBitSet::reset(SizeType _position) -> RoaringBitSet&
+{
+	if (_position > MAX_POSITION) return *this;
+
+	auto key = this->key(_position);
+	auto iterator = std::lower_bound(_chunks.begin(), _chunks.end(), key, less);
+	if (iterator == _chunks.end() or iterator->_key != key) return *this;
+
+	auto& container = iterator->_container;
+	container.reset(low(_position));
+	if (container.size() <= 0) _chunks.erase(iterator);
+	return *this;
+}
+
+// 查找首个有效位
+auto RoaringBitSet::find(SizeType _position) const noexcept -> SizeType
+{
+	if (_position > MAX_POSITION) return NPOS;
+
+	auto key = this->key(_position);
+	auto iterator = std::lower_bound(_chunks.begin(), _chunks.end(), key, less);
+
+	auto index = static_cast<SizeType>(iterator - _chunks.begin());
+	SizeType low = iterator != _chunks.end() and iterator->_key == key \
+		? this->low(_position) : 0;
+
+	Iterator result(_chunks, index, low);
+	return result != end() ? *result : NPOS;
+}
+
+// 复制指定范围
+RoaringBitSet RoaringBitSet::copy(SizeType _begin, SizeType _end) const
+{
+	RoaringBitSet bitSet;
+	for (auto position = find(_begin); \
+		position < _end and position != NPOS; )
+	{
+		bitSet.set(position - _begin);
+		position = position < MAX_POSITION ? find(position + 1) : NPOS;
+	}
+	return bitSet;
+}
+
+void RoaringBitSet::optimize()
+{
+	for (auto& chunk : _chunks)
+		chunk._container.optimize();
+}
+
+// 跳至首个有效位
+void RoaringBitSet::Iterator::seek() noexcept
+{
+	for (auto size = _chunks->size(); _index < size; )
+	{
+		_low = (*_chunks)[_index]._container.find(_low, _cursor);
+		if (_low < CHUNK_SIZE) return;
+
+		++_index;
+		_low = 0;
+		_cursor = 0;
+	}
+	_low = 0;
+}
+
+ETERFREE_SPACE_END
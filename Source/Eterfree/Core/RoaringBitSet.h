@@ -0,0 +1,348 @@
+﻿#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <variant>
+#include <vector>
+
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 压缩位集合：仿照Roaring位图，按位置之高十六位分块，块内依基数选择容器，
+ * 稀疏块为有序数组，稠密块为位图，optimize()可将连续块转换为游程。
+ * 位置限于三十二位，适用于大范围内之稀疏位置。
+ */
+class RoaringBitSet final
+{
+public:
+	using SizeType = std::size_t;
+
+	// 查找失败之位置
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	// 位置上限
+	static constexpr SizeType MAX_POSITION = UINT32_MAX;
+
+	class Iterator;
+
+private:
+	using KeyType = std::uint16_t;
+	using LowType = std::uint16_t;
+
+	// 块内位数量
+	static constexpr SizeType CHUNK_SIZE = SizeType(1) << 16;
+
+	// 数组容器之元素上限，超过则转换为位图
+	static constexpr SizeType ARRAY_SIZE = 4096;
+
+	// 求交时数组元素少于此数量则逐个二分探测
+	static constexpr SizeType PROBE_SIZE = 256;
+
+	// 二元操作类型
+	enum OPERATION_TYPE : std::uint8_t
+	{
+		OPERATION_AND,
+		OPERATION_OR,
+		OPERATION_XOR
+	};
+
+	// 容器：存储块内位置之低十六位
+	class Container final
+	{
+	public:
+		// 游程：闭区间
+		struct Run
+		{
+			LowType _begin;
+			LowType _last;
+		};
+
+		using Array = std::vector<LowType>;
+		using Bitmap = std::vector<std::uint64_t>;
+		using Runs = std::vector<Run>;
+
+		// 位图之字数量
+		static constexpr SizeType BITMAP_SIZE = CHUNK_SIZE / 64;
+
+	private:
+		std::variant<Array, Bitmap, Runs> _data;
+		SizeType _size; // 基数
+
+	private:
+		static Container make(Bitmap&& _bitmap);
+
+		// 转换为位图
+		Bitmap bitmap() const;
+
+		// 位图基数不超过数组上限则转换为数组
+		void shrink();
+
+		// 游程转换为数组或位图，以便修改
+		void normalize();
+
+	public:
+		Container() : _size(0) {}
+
+		template <OPERATION_TYPE _OPERATION>
+		static Container apply(const Container& _left, \
+			const Container& _right);
+
+		bool operator==(const Container& _container) const;
+
+		auto size() const noexcept
+		{
+			return _size;
+		}
+
+		// 内存占用字节数
+		SizeType usage() const noexcept;
+
+		bool exist(LowType _low) const noexcept;
+
+		// 查找不小于_low之首个有效位，_cursor为单调提示，未找到则返回CHUNK_SIZE
+		SizeType find(SizeType _low, SizeType& _cursor) const noexcept;
+
+		void set(LowType _low);
+
+		void reset(LowType _low);
+
+		// 游程数量较少则转换为游程
+		void optimize();
+	};
+
+	struct Chunk
+	{
+		KeyType _key;
+		Container _container;
+	};
+
+private:
+	std::vector<Chunk> _chunks; // 按键升序
+
+private:
+	static constexpr KeyType key(SizeType _position) noexcept
+	{
+		return static_cast<KeyType>(_position >> 16);
+	}
+
+	static constexpr LowType low(SizeType _position) noexcept
+	{
+		return static_cast<LowType>(_position);
+	}
+
+	template <OPERATION_TYPE _OPERATION>
+	static RoaringBitSet apply(const RoaringBitSet& _left, \
+		const RoaringBitSet& _right);
+
+	// 按键比较块
+	static bool less(const Chunk& _chunk, KeyType _key) noexcept
+	{
+		return _chunk._key < _key;
+	}
+
+private:
+	// 查找键所属块之容器，不存在则返回nullptr
+	const Container* container(KeyType _key) const noexcept;
+
+public:
+	friend RoaringBitSet operator&(const RoaringBitSet& _left, \
+		const RoaringBitSet& _right);
+
+	friend RoaringBitSet operator|(const RoaringBitSet& _left, \
+		const RoaringBitSet& _right);
+
+	friend RoaringBitSet operator^(const RoaringBitSet& _left, \
+		const RoaringBitSet& _right);
+
+public:
+	RoaringBitSet() = default;
+
+	// 自稠密位集合转换，忽略超出位置上限之位
+	template <std::unsigned_integral _ValueType>
+	explicit RoaringBitSet(const BitSet<_ValueType>& _bitSet)
+	{
+		for (auto position : _bitSet)
+		{
+			if (position > MAX_POSITION) break;
+			set(position);
+		}
+	}
+
+	bool operator==(const RoaringBitSet& _bitSet) const;
+
+	bool operator[](SizeType _position) const noexcept
+	{
+		return exist(_position);
+	}
+
+	RoaringBitSet& operator&=(const RoaringBitSet& _bitSet)
+	{
+		return *this = *this & _bitSet;
+	}
+
+	RoaringBitSet& operator|=(const RoaringBitSet& _bitSet)
+	{
+		return *this = *this | _bitSet;
+	}
+
+	RoaringBitSet& operator^=(const RoaringBitSet& _bitSet)
+	{
+		return *this = *this ^ _bitSet;
+	}
+
+	// 存在有效位
+	bool exist(SizeType _position) const noexcept;
+
+	// 块数量
+	auto chunks() const noexcept
+	{
+		return _chunks.size();
+	}
+
+	// 内存占用字节数
+	SizeType usage() const noexcept;
+
+	// 统计有效位
+	SizeType count() const noexcept;
+
+	bool any() const noexcept
+	{
+		return not _chunks.empty();
+	}
+
+	bool none() const noexcept
+	{
+		return _chunks.empty();
+	}
+
+	// 设置指定位，超出位置上限则无效
+	RoaringBitSet& set(SizeType _position, bool _value = true);
+
+	RoaringBitSet& reset(SizeType _position);
+
+	// 重置所有位
+	RoaringBitSet& reset() noexcept
+	{
+		_chunks.clear();
+		return *this;
+	}
+
+	RoaringBitSet& flip(SizeType _position)
+	{
+		return set(_position, not exist(_position));
+	}
+
+	// 查找位置不小于_position之首个有效位
+	SizeType find(SizeType _position) const noexcept;
+
+	SizeType first() const noexcept
+	{
+		return find(0);
+	}
+
+	// 遍历有效位
+	Iterator begin() const noexcept;
+
+	Iterator end() const noexcept;
+
+	// 复制指定范围，移至低位
+	RoaringBitSet copy(SizeType _begin, SizeType _end) const;
+
+	// 转换稠密位集合
+	template <std::unsigned_integral _ValueType>
+	BitSet<_ValueType> dense() const;
+
+	// 连续位较多之块转换为游程，以节省内存
+	void optimize();
+};
+
+// 有效位迭代器：解引用为位置
+class RoaringBitSet::Iterator final
+{
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using difference_type = std::ptrdiff_t;
+	using value_type = SizeType;
+	using pointer = void;
+	using reference = SizeType;
+
+private:
+	const std::vector<Chunk>* _chunks;
+	SizeType _index; // 块索引
+	SizeType _low; // 块内位置
+	SizeType _cursor; // 容器内游标
+
+private:
+	// 跳至首个有效位
+	void seek() noexcept;
+
+public:
+	Iterator() noexcept : \
+		_chunks(nullptr), _index(0), _low(0), _cursor(0) {}
+
+	Iterator(const std::vector<Chunk>& _chunks, \
+		SizeType _index, SizeType _low = 0) noexcept : \
+		_chunks(&_chunks), _index(_index), _low(_low), _cursor(0)
+	{
+		seek();
+	}
+
+	bool operator==(const Iterator& _iterator) const noexcept
+	{
+		return _index == _iterator._index and _low == _iterator._low;
+	}
+
+	SizeType operator*() const noexcept
+	{
+		return SizeType((*_chunks)[_index]._key) << 16 | _low;
+	}
+
+	Iterator& operator++() noexcept
+	{
+		++_low;
+		seek();
+		return *this;
+	}
+
+	Iterator operator++(int) noexcept
+	{
+		auto iterator = *this;
+		++*this;
+		return iterator;
+	}
+};
+
+inline auto RoaringBitSet::begin() const noexcept -> Iterator
+{
+	return Iterator(_chunks, 0);
+}
+
+inline auto RoaringBitSet::end() const noexcept -> Iterator
+{
+	return Iterator(_chunks, _chunks.size());
+}
+
+// 转换稠密位集合
+template <std::unsigned_integral _ValueType>
+BitSet<_ValueType> RoaringBitSet::dense() const
+{
+	constexpr SizeType BITS = CHAR_BIT * sizeof(_ValueType);
+
+	if (_chunks.empty()) return BitSet<_ValueType>();
+
+	// 末块决定元素数量
+	SizeType last = SizeType(_chunks.back()._key) << 16 | (CHUNK_SIZE - 1);
+
+	BitSet<_ValueType> bitSet;
+	bitSet.resize(last / BITS + 1);
+	for (auto position : *this)
+		bitSet.set(position);
+	return bitSet;
+}
+
+ETERFREE_SPACE_END
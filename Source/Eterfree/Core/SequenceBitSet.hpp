@@ -0,0 +1,155 @@
+﻿#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 序列位集合：以环形位集合跟踪六十四位序列号之滑动窗口[base, base + capacity)，
+ * 用于重放去重与确认跟踪。容量于构造时向上取整为二的幂，内存固定；
+ * 前移窗口仅重置腾出之位，不移动元素，标记与查询为常数时间，前移为均摊常数时间。
+ * 基准以下之序列号视为已标记。
+ */
+template <std::unsigned_integral _ValueType>
+class SequenceBitSet final
+{
+public:
+	using ValueType = _ValueType;
+	using SequenceType = std::uint64_t;
+	using SizeType = typename BitSet<ValueType>::SizeType;
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = CHAR_BIT * sizeof(ValueType);
+
+private:
+	BitSet<ValueType> _bitSet;
+	SizeType _mask; // 容量减一
+	SequenceType _base; // 窗口首个序列号
+
+private:
+	// 序列号之环形位置
+	SizeType position(SequenceType _sequence) const noexcept
+	{
+		return static_cast<SizeType>(_sequence) & _mask;
+	}
+
+public:
+	SequenceBitSet(SizeType _capacity, SequenceType _base = 0) : \
+		_bitSet(std::bit_ceil(std::max(_capacity, BIT_SIZE)) / BIT_SIZE), \
+		_mask(std::bit_ceil(std::max(_capacity, BIT_SIZE)) - 1), \
+		_base(_base) {}
+
+	// 窗口之位数量
+	auto capacity() const noexcept
+	{
+		return _mask + 1;
+	}
+
+	auto base() const noexcept
+	{
+		return _base;
+	}
+
+	// 窗口内已标记数量
+	auto count() const noexcept
+	{
+		return _bitSet.count();
+	}
+
+	// 清空窗口并重设基准
+	void reset(SequenceType _base) noexcept
+	{
+		_bitSet.reset();
+		this->_base = _base;
+	}
+
+	// 已标记或位于基准以下
+	bool test(SequenceType _sequence) const noexcept
+	{
+		if (_sequence < _base) return true;
+		if (_sequence - _base > _mask) return false;
+		return _bitSet.exist(position(_sequence));
+	}
+
+	// 标记序列号，返回是否首次标记；超出窗口则前移窗口至容纳之
+	bool mark(SequenceType _sequence) noexcept;
+
+	// 前移窗口基准，重置腾出之位；不可后移
+	void advance(SequenceType _base) noexcept;
+
+	// 首个未标记序列号，窗口已满则为窗口上界
+	SequenceType gap() const noexcept;
+
+	// 前移窗口至首个未标记序列号，即累计确认，返回新基准
+	SequenceType slide() noexcept
+	{
+		auto base = gap();
+		advance(base);
+		return base;
+	}
+};
+
+template <std::unsigned_integral _ValueType>
+bool SequenceBitSet<_ValueType>::mark(SequenceType _sequence) noexcept
+{
+	if (_sequence < _base) return false;
+
+	if (_sequence - _base > _mask)
+		advance(_sequence - _mask);
+
+	auto position = this->position(_sequence);
+	if (_bitSet.exist(position)) return false;
+
+	// 位置不超出容量，无需扩容
+	_bitSet.set(position);
+	return true;
+}
+
+template <std::unsigned_integral _ValueType>
+void SequenceBitSet<_ValueType>::advance(SequenceType _base) noexcept
+{
+	if (_base <= this->_base) return;
+
+	// 越过整个窗口则全部重置
+	if (_base - this->_base > _mask)
+		_bitSet.reset();
+	else
+	{
+		auto begin = position(this->_base);
+		auto end = position(_base);
+		if (begin < end)
+			_bitSet.reset(begin, end);
+		else
+		{
+			_bitSet.reset(begin, capacity());
+			_bitSet.reset(0, end);
+		}
+	}
+	this->_base = _base;
+}
+
+template <std::unsigned_integral _ValueType>
+auto SequenceBitSet<_ValueType>::gap() const noexcept -> SequenceType
+{
+	auto begin = position(_base);
+
+	// 先查找基准至末尾，再回绕查找开头至基准
+	auto position = _bitSet.find(begin, false);
+	if (position <= _mask)
+		return _base + (position - begin);
+
+	position = _bitSet.find(0, false);
+	if (position < begin)
+		return _base + (capacity() - begin + position);
+	return _base + capacity();
+}
+
+ETERFREE_SPACE_END
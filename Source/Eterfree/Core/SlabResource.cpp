@@ -0,0 +1,238 @@
+﻿#include "SlabResource.h"
+
+#include <bit>
+#include <algorithm>
+
+ETERFREE_SPACE_BEGIN
+
+// 块：连续槽位与空闲位集合
+struct SlabResource::Slab final
+{
+	using ValueType = std::uint64_t;
+
+	// 单元素之位数量
+	static constexpr SizeType BIT_SIZE = 64;
+
+	// 不在可用列表之下标
+	static constexpr SizeType NPOS = ~static_cast<SizeType>(0);
+
+	char* _data;
+	BitSet<ValueType> _free; // 空闲槽位
+	std::uint64_t _summary; // 含空闲槽位之元素
+	SizeType _size; // 空闲槽位数量
+	SizeType _index; // 于可用列表之下标
+
+	Slab(char* _data, SizeType _slots) : \
+		_data(_data), _free((_slots + BIT_SIZE - 1) / BIT_SIZE), \
+		_summary(0), _size(_slots), _index(NPOS)
+	{
+		_free.set(0, _slots);
+
+		auto size = _free.size();
+		_summary = size < BIT_SIZE ? \
+			(static_cast<std::uint64_t>(1) << size) - 1 : ~_summary;
+	}
+};
+
+// 尺寸等级：按块首地址索引所有块，可用列表含有空闲槽位之块
+struct SlabResource::SizeClass final
+{
+	SizeType _size; // 槽位字节数
+	SizeType _slots; // 块之槽位数量
+	SizeType _empty; // 空闲块数量
+
+	std::map<std::uintptr_t, std::unique_ptr<Slab>> _slabs;
+	std::vector<Slab*> _available;
+
+	SizeClass(SizeType _size) : _size(_size), \
+		_slots(std::clamp(SLAB_SIZE / _size, MIN_SLOTS, MAX_SLOTS)), \
+		_empty(0) {}
+
+	auto bytes() const noexcept
+	{
+		return _size * _slots;
+	}
+
+	void remove(Slab& _slab) noexcept
+	{
+		auto last = _available.back();
+		last->_index = _slab._index;
+		_available[_slab._index] = last;
+		_available.pop_back();
+		_slab._index = Slab::NPOS;
+	}
+};
+
+auto SlabResource::classify(SizeType _size, \
+	SizeType _alignment) const noexcept -> SizeType
+{
+	// 块按缓存行对齐，更大之对齐无法满足
+	auto size = std::max(_size, MIN_SIZE);
+	if (size > _classes.back()._size or _alignment > MIN_SIZE)
+		return _classes.size();
+
+	// 四倍缓存行以内按缓存行递增
+	if (size <= STEPS * MIN_SIZE)
+		return (size - 1) / MIN_SIZE;
+
+	// 位于(2^p, 2^(p+1)]，步长为2^(p-2)
+	auto power = static_cast<SizeType>(std::bit_width(size - 1) - 1);
+	auto step = static_cast<SizeType>(1) << (power - 2);
+	auto base = (power - std::countr_zero(STEPS * MIN_SIZE) + 1) * STEPS;
+	return base + ((size - (static_cast<SizeType>(1) << power) - 1) / step);
+}
+
+void SlabResource::create(SizeClass& _class)
+{
+	auto bytes = _class.bytes();
+	auto data = static_cast<char*>(_upstream->allocate(bytes, MIN_SIZE));
+
+	auto slab = std::make_unique<Slab>(data, _class._slots);
+	slab->_index = _class._available.size();
+	_class._available.push_back(slab.get());
+
+	try
+	{
+		_class._slabs.emplace(reinterpret_cast<std::uintptr_t>(data), \
+			std::move(slab));
+	}
+	catch (...)
+	{
+		_class._available.pop_back();
+		_upstream->deallocate(data, bytes, MIN_SIZE);
+		throw;
+	}
+
+	++_class._empty;
+	_usage += bytes;
+}
+
+auto SlabResource::take(Slab& _slab) noexcept -> SizeType
+{
+	auto data = _slab._free.data();
+	auto index = static_cast<SizeType>(std::countr_zero(_slab._summary));
+
+	auto& element = data[index];
+	auto position = static_cast<SizeType>(std::countr_zero(element));
+
+	// 清除最低有效位，元素无空闲槽位则清除摘要位
+	element &= element - 1;
+	if (element == 0)
+		_slab._summary &= ~(static_cast<std::uint64_t>(1) << index);
+
+	--_slab._size;
+	return index * Slab::BIT_SIZE + position;
+}
+
+void* SlabResource::do_allocate(std::size_t _size, std::size_t _alignment)
+{
+	auto index = classify(_size, _alignment);
+	if (index >= _classes.size())
+		return _upstream->allocate(_size, _alignment);
+
+	auto& sizeClass = _classes[index];
+	if (sizeClass._available.empty()) create(sizeClass);
+
+	auto& slab = *sizeClass._available.back();
+	if (slab._size == sizeClass._slots) --sizeClass._empty;
+
+	auto slot = take(slab);
+	if (slab._size <= 0) sizeClass.remove(slab);
+	_allocated += sizeClass._size;
+	return slab._data + slot * sizeClass._size;
+}
+
+void SlabResource::do_deallocate(void* _pointer, std::size_t _size, \
+	std::size_t _alignment)
+{
+	auto index = classify(_size, _alignment);
+	if (index >= _classes.size())
+	{
+		_upstream->deallocate(_pointer, _size, _alignment);
+		return;
+	}
+
+	// 首地址不大于指针之末个块
+	auto& sizeClass = _classes[index];
+	auto address = reinterpret_cast<std::uintptr_t>(_pointer);
+	auto& slab = *std::prev(sizeClass._slabs.upper_bound(address))->second;
+
+	auto slot = (address - reinterpret_cast<std::uintptr_t>(slab._data)) \
+		/ sizeClass._size;
+	auto offset = slot / Slab::BIT_SIZE;
+	slab._free.data()[offset] |= generateBit<Slab::ValueType>(slot % Slab::BIT_SIZE);
+	slab._summary |= static_cast<std::uint64_t>(1) << offset;
+
+	if (slab._size++ <= 0)
+	{
+		slab._index = sizeClass._available.size();
+		sizeClass._available.push_back(&slab);
+	}
+
+	if (slab._size == sizeClass._slots) ++sizeClass._empty;
+	_allocated -= sizeClass._size;
+}
+
+SlabResource::SlabResource(SizeType _maxSize, \
+	std::pmr::memory_resource* _upstream) : \
+	_upstream(_upstream), _usage(0), _allocated(0)
+{
+	_maxSize = std::bit_ceil(std::max(_maxSize, STEPS * MIN_SIZE));
+	for (auto size = MIN_SIZE; size <= STEPS * MIN_SIZE; size += MIN_SIZE)
+		_classes.emplace_back(size);
+
+	for (auto power = STEPS * MIN_SIZE; power < _maxSize; power <<= 1)
+		for (SizeType step = 1; step <= STEPS; ++step)
+			_classes.emplace_back(power + step * power / STEPS);
+}
+
+SlabResource::~SlabResource() noexcept
+{
+	release();
+}
+
+auto SlabResource::maxSize() const noexcept -> SizeType
+{
+	return _classes.back()._size;
+}
+
+void SlabResource::trim(SizeType _reserve) noexcept
+{
+	for (auto& sizeClass : _classes)
+	{
+		auto bytes = sizeClass.bytes();
+
+		// 逆序遍历，移除不影响未遍历之下标
+		for (auto index = sizeClass._available.size(); \
+			sizeClass._empty > _reserve and index > 0; --index)
+		{
+			auto& slab = *sizeClass._available[index - 1];
+			if (slab._size < sizeClass._slots) continue;
+
+			auto data = slab._data;
+			sizeClass.remove(slab);
+			sizeClass._slabs.erase(reinterpret_cast<std::uintptr_t>(data));
+
+			_upstream->deallocate(data, bytes, MIN_SIZE);
+			_usage -= bytes;
+			--sizeClass._empty;
+		}
+	}
+}
+
+void SlabResource::release() noexcept
+{
+	for (auto& sizeClass : _classes)
+	{
+		auto bytes = sizeClass.bytes();
+		for (auto& [address, slab] : sizeClass._slabs)
+			_upstream->deallocate(slab->_data, bytes, MIN_SIZE);
+
+		sizeClass._slabs.clear();
+		sizeClass._available.clear();
+		sizeClass._empty = 0;
+	}
+	_usage = _allocated = 0;
+}
+
+ETERFREE_SPACE_END
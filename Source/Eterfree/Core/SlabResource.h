@@ -0,0 +1,109 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <memory_resource>
+
+#include "BitSet.hpp"
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 分块内存资源：尺寸等级为缓存行之倍数，四倍缓存行以上于相邻二的幂之间四等分，
+ * 内部碎片不超过四分之一。每级由若干固定槽位之块组成，块以位集合记录空闲槽位，
+ * 另以摘要字记录含空闲槽位之元素，两次计数尾零即定位槽位。
+ * 块按缓存行对齐，超出最大等级或对齐大于缓存行之请求转交上游资源。
+ * 释放槽位仅设置位，空闲块由trim批量归还上游，可每级保留少量空闲块以免反复分配。非线程安全，宜每个线程或分片独占。
+ */
+class SlabResource final : public std::pmr::memory_resource
+{
+public:
+	using SizeType = std::size_t;
+
+	// 最小尺寸等级，亦为缓存行字节数
+	static constexpr SizeType MIN_SIZE = 64;
+
+	// 相邻二的幂之间之等级数量
+	static constexpr SizeType STEPS = 4;
+
+	// 块之目标字节数
+	static constexpr SizeType SLAB_SIZE = 64 * 1024;
+
+	// 块之槽位数量范围，上限为摘要字之位数量与元素位数量之积
+	static constexpr SizeType MIN_SLOTS = 4;
+	static constexpr SizeType MAX_SLOTS = 64 * 64;
+
+private:
+	struct Slab;
+	struct SizeClass;
+
+private:
+	std::pmr::memory_resource* _upstream;
+	std::vector<SizeClass> _classes;
+	SizeType _usage; // 自上游分配之块字节数
+	SizeType _allocated; // 已分配之槽位字节数
+
+private:
+	// 尺寸等级之下标，超出最大等级则为等级数量
+	SizeType classify(SizeType _size, SizeType _alignment) const noexcept;
+
+	// 自上游分配新块，加入可用列表
+	void create(SizeClass& _class);
+
+	// 块首个空闲槽位
+	static SizeType take(Slab& _slab) noexcept;
+
+protected:
+	void* do_allocate(std::size_t _size, std::size_t _alignment) override;
+
+	void do_deallocate(void* _pointer, std::size_t _size, \
+		std::size_t _alignment) override;
+
+	bool do_is_equal(const std::pmr::memory_resource& _resource) const noexcept override
+	{
+		return this == &_resource;
+	}
+
+public:
+	// _maxSize为最大尺寸等级，向上取整为二的幂且不小于四倍缓存行
+	explicit SlabResource(SizeType _maxSize = SLAB_SIZE, \
+		std::pmr::memory_resource* _upstream = std::pmr::get_default_resource());
+
+	~SlabResource() noexcept override;
+
+	SlabResource(const SlabResource&) = delete;
+
+	SlabResource& operator=(const SlabResource&) = delete;
+
+	auto upstream() const noexcept
+	{
+		return _upstream;
+	}
+
+	// 最大尺寸等级
+	SizeType maxSize() const noexcept;
+
+	// 块占用字节数，不含转交上游之请求
+	auto usage() const noexcept
+	{
+		return _usage;
+	}
+
+	// 已分配之槽位字节数，与usage之差为空闲槽位字节数
+	auto allocated() const noexcept
+	{
+		return _allocated;
+	}
+
+	// 归还空闲块，每级至多保留_reserve个
+	void trim(SizeType _reserve = 0) noexcept;
+
+	// 归还所有块，已分配之槽位随之失效
+	void release() noexcept;
+};
+
+ETERFREE_SPACE_END
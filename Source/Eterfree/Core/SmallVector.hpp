@@ -0,0 +1,247 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "Common.hpp"
+
+ETERFREE_SPACE_BEGIN
+
+/*
+ * 小缓冲向量：元素数量不超过_INLINE_SIZE时存储于对象内部，无需分配堆内存；
+ * 超过则存储于堆。内部缓冲与堆指针共用存储，仅适用于可平凡复制之元素。
+ */
+template <typename _Type, std::size_t _INLINE_SIZE>
+class SmallVector final
+{
+	static_assert(std::is_trivially_copyable_v<_Type>, \
+		"The type is not trivially copyable.");
+
+public:
+	using value_type = _Type;
+	using size_type = std::size_t;
+
+	using iterator = _Type*;
+	using const_iterator = const _Type*;
+
+	static constexpr size_type INLINE_SIZE = _INLINE_SIZE;
+
+private:
+	struct Heap
+	{
+		_Type* _data;
+		size_type _capacity;
+	};
+
+private:
+	size_type _size;
+
+	union
+	{
+		_Type _buffer[INLINE_SIZE];
+		Heap _heap;
+	};
+
+private:
+	static constexpr bool local(size_type _size) noexcept
+	{
+		return _size <= INLINE_SIZE;
+	}
+
+	void release() noexcept
+	{
+		if (not local(_size)) delete[] _heap._data;
+	}
+
+	// 接管另一向量之元素，当前向量须无堆存储
+	void take(SmallVector& _vector) noexcept
+	{
+		_size = _vector._size;
+		if (local(_size))
+			std::memcpy(_buffer, _vector._buffer, sizeof _buffer);
+		else
+			_heap = _vector._heap;
+		_vector._size = 0;
+	}
+
+	// 改变元素数量，保留前缀元素，不初始化新增元素
+	void reserve(size_type _size);
+
+public:
+	SmallVector() noexcept : _size(0) {}
+
+	SmallVector(size_type _size, const _Type& _value) : SmallVector()
+	{
+		resize(_size, _value);
+	}
+
+	SmallVector(const _Type* _first, const _Type* _last) : SmallVector()
+	{
+		auto size = static_cast<size_type>(_last - _first);
+		reserve(size);
+		std::copy(_first, _last, local(size) ? _buffer : _heap._data);
+	}
+
+	SmallVector(const SmallVector& _vector) : SmallVector()
+	{
+		if (_vector.local())
+		{
+			std::memcpy(_buffer, _vector._buffer, sizeof _buffer);
+			_size = _vector._size;
+			return;
+		}
+
+		reserve(_vector._size);
+		std::copy(_vector._heap._data, \
+			_vector._heap._data + _size, _heap._data);
+	}
+
+	SmallVector(SmallVector&& _vector) noexcept : SmallVector()
+	{
+		take(_vector);
+	}
+
+	~SmallVector() noexcept
+	{
+		release();
+	}
+
+	SmallVector& operator=(const SmallVector& _vector)
+	{
+		if (this != &_vector)
+		{
+			SmallVector vector(_vector);
+			release();
+			take(vector);
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& _vector) noexcept
+	{
+		if (this != &_vector)
+		{
+			release();
+			take(_vector);
+		}
+		return *this;
+	}
+
+	_Type& operator[](size_type _index) noexcept
+	{
+		return data()[_index];
+	}
+
+	const _Type& operator[](size_type _index) const noexcept
+	{
+		return data()[_index];
+	}
+
+	// 存储于对象内部
+	bool local() const noexcept
+	{
+		return local(_size);
+	}
+
+	auto size() const noexcept
+	{
+		return _size;
+	}
+
+	bool empty() const noexcept
+	{
+		return _size <= 0;
+	}
+
+	_Type* data() noexcept
+	{
+		return local() ? _buffer : _heap._data;
+	}
+
+	const _Type* data() const noexcept
+	{
+		return local() ? _buffer : _heap._data;
+	}
+
+	auto begin() noexcept
+	{
+		return data();
+	}
+
+	auto begin() const noexcept
+	{
+		return data();
+	}
+
+	auto end() noexcept
+	{
+		return data() + _size;
+	}
+
+	auto end() const noexcept
+	{
+		return data() + _size;
+	}
+
+	_Type& back() noexcept
+	{
+		return data()[_size - 1];
+	}
+
+	const _Type& back() const noexcept
+	{
+		return data()[_size - 1];
+	}
+
+	void resize(size_type _size, const _Type& _value)
+	{
+		auto size = this->_size;
+		reserve(_size);
+		if (_size > size)
+			std::fill(data() + size, data() + _size, _value);
+	}
+
+	void assign(size_type _size, const _Type& _value)
+	{
+		reserve(_size);
+		std::fill(begin(), end(), _value);
+	}
+};
+
+template <typename _Type, std::size_t _INLINE_SIZE>
+void SmallVector<_Type, _INLINE_SIZE>::reserve(size_type _size)
+{
+	if (_size == this->_size) return;
+
+	auto size = std::min(this->_size, _size);
+	if (local(_size))
+	{
+		// 堆存储迁回内部缓冲
+		if (not local())
+		{
+			auto heap = _heap;
+			std::copy(heap._data, heap._data + size, _buffer);
+			delete[] heap._data;
+		}
+	}
+	else if (local())
+	{
+		auto data = new _Type[_size];
+		std::copy(_buffer, _buffer + size, data);
+		_heap = { data, _size };
+	}
+	else if (_size > _heap._capacity)
+	{
+		// 按倍数扩容，摊销逐次增长
+		auto capacity = std::max(_size, _heap._capacity * 2);
+		auto data = new _Type[capacity];
+		std::copy(_heap._data, _heap._data + size, data);
+		delete[] _heap._data;
+		_heap = { data, capacity };
+	}
+	this->_size = _size;
+}
+
+ETERFREE_SPACE_END
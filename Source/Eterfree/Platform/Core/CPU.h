@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) and not defined(__clang__) \
+	and (defined(_M_X64) or defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "Eterfree/Platform/Common.h"
+
+#if defined(__x86_64__) or defined(__i386__) \
+	or defined(_M_X64) or defined(_M_IX86)
+#define PLATFORM_X86
+#endif
+
+#if defined(__ARM_NEON) or defined(_M_ARM64)
+#define PLATFORM_NEON
+#endif
+
+// 为单个函数启用指令集扩展，以便运行时分派
+#if defined(__GNUC__) or defined(__clang__)
+#define PLATFORM_TARGET(feature) __attribute__((target(feature)))
+#else
+#define PLATFORM_TARGET(feature)
+#endif
+
+PLATFORM_SPACE_BEGIN
+
+// 指令集扩展
+enum ISA_TYPE : std::uint8_t
+{
+	ISA_SSSE3,
+	ISA_POPCNT,
+	ISA_AVX2,
+	ISA_AVX512BW,
+	ISA_NEON
+};
+
+// 运行时检测处理器是否支持指令集扩展
+inline bool support(ISA_TYPE _isa) noexcept
+{
+#if defined(PLATFORM_X86) and (defined(__GNUC__) or defined(__clang__))
+	switch (_isa)
+	{
+	case ISA_SSSE3:
+		return __builtin_cpu_supports("ssse3");
+	case ISA_POPCNT:
+		return __builtin_cpu_supports("popcnt");
+	case ISA_AVX2:
+		return __builtin_cpu_supports("avx2");
+	case ISA_AVX512BW:
+		return __builtin_cpu_supports("avx512bw");
+	default:
+		return false;
+	}
+
+#elif defined(PLATFORM_X86) and defined(_MSC_VER)
+	static const auto features = []
+	{
+		int info[4] = {};
+		__cpuid(info, 0);
+		auto maximum = info[0];
+
+		std::uint8_t features = 0;
+		if (maximum < 1) return features;
+
+		__cpuid(info, 1);
+		auto ecx = static_cast<unsigned>(info[2]);
+		if (ecx & 1U << 9) features |= 1U << ISA_SSSE3;
+		if (ecx & 1U << 23) features |= 1U << ISA_POPCNT;
+
+		// 操作系统须保存YMM寄存器，AVX-512另须保存ZMM与掩码寄存器
+		auto xcr0 = (ecx & 1U << 27) ? _xgetbv(0) : 0;
+		bool avx = (ecx & 1U << 28) and (xcr0 & 0x6) == 0x6;
+		if (avx and maximum >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			auto ebx = static_cast<unsigned>(info[1]);
+			if (ebx & 1U << 5)
+				features |= 1U << ISA_AVX2;
+			if ((ebx & 1U << 16) and (ebx & 1U << 30) \
+				and (xcr0 & 0xE6) == 0xE6)
+				features |= 1U << ISA_AVX512BW;
+		}
+		return features;
+	}();
+	return features & 1U << _isa;
+
+#elif defined(PLATFORM_NEON)
+	return _isa == ISA_NEON;
+
+#else
+	return false;
+#endif
+}
+
+// 预取地址所在缓存行，不改变程序语义
+inline void prefetch(const void* _address) noexcept
+{
+#if defined(__GNUC__) or defined(__clang__)
+	__builtin_prefetch(_address);
+#elif defined(PLATFORM_X86) and defined(_MSC_VER)
+	_mm_prefetch(static_cast<const char*>(_address), _MM_HINT_T0);
+#else
+	static_cast<void>(_address);
+#endif
+}
+
+PLATFORM_SPACE_END
@@ -0,0 +1,214 @@
+﻿#include "Endian.h"
+#include "CPU.h"
+
+#include <array>
+
+#if defined(PLATFORM_X86)
+#include <immintrin.h>
+#elif defined(PLATFORM_NEON)
+#include <arm_neon.h>
+#endif
+
+PLATFORM_SPACE_BEGIN
+
+// 批量反转字节序之核心函数，_size为字节数
+using Kernel = void (*)(std::uint8_t*, const std::uint8_t*, std::size_t);
+
+template <std::size_t _WIDTH>
+static void swapScalar(std::uint8_t* _target, \
+	const std::uint8_t* _source, std::size_t _size) noexcept
+{
+	using Type = typename Unsigned<_WIDTH>::Type;
+
+	for (decltype(_size) offset = 0; offset < _size; offset += _WIDTH)
+	{
+		Type value;
+		std::memcpy(&value, _source + offset, _WIDTH);
+		value = byteswap(value);
+		std::memcpy(_target + offset, &value, _WIDTH);
+	}
+}
+
+#if defined(PLATFORM_X86)
+// 字节重排掩码：每个元素内部首尾颠倒
+template <std::size_t _WIDTH>
+static constexpr auto getMask() noexcept
+{
+	std::array<std::uint8_t, 64> mask = {};
+	for (std::size_t index = 0; index < mask.size(); ++index)
+	{
+		auto offset = index % 16;
+		mask[index] = static_cast<std::uint8_t>(offset / _WIDTH * _WIDTH \
+			+ _WIDTH - 1 - offset % _WIDTH);
+	}
+	return mask;
+}
+
+template <std::size_t _WIDTH>
+static constexpr auto MASK = getMask<_WIDTH>();
+
+template <std::size_t _WIDTH>
+PLATFORM_TARGET("ssse3")
+static void swapSSSE3(std::uint8_t* _target, \
+	const std::uint8_t* _source, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(__m128i);
+
+	auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(MASK<_WIDTH>.data()));
+
+	decltype(_size) offset = 0;
+	for (; offset + BLOCK <= _size; offset += BLOCK)
+	{
+		auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_source + offset));
+		value = _mm_shuffle_epi8(value, mask);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_target + offset), value);
+	}
+
+	swapScalar<_WIDTH>(_target + offset, _source + offset, _size - offset);
+}
+
+template <std::size_t _WIDTH>
+PLATFORM_TARGET("avx2")
+static void swapAVX2(std::uint8_t* _target, \
+	const std::uint8_t* _source, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(__m256i);
+
+	auto mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(MASK<_WIDTH>.data()));
+
+	decltype(_size) offset = 0;
+	for (; offset + BLOCK * 2 <= _size; offset += BLOCK * 2)
+	{
+		auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_source + offset));
+		auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_source + offset + BLOCK));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(_target + offset), \
+			_mm256_shuffle_epi8(low, mask));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(_target + offset + BLOCK), \
+			_mm256_shuffle_epi8(high, mask));
+	}
+
+	for (; offset + BLOCK <= _size; offset += BLOCK)
+	{
+		auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_source + offset));
+		value = _mm256_shuffle_epi8(value, mask);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(_target + offset), value);
+	}
+
+	swapScalar<_WIDTH>(_target + offset, _source + offset, _size - offset);
+}
+
+/*
+ * AVX2每周期仅能重排32字节，约为memcpy吞吐量之一半，
+ * 展开循环与对齐写入均无明显收益；
+ * AVX-512每周期重排64字节，可达memcpy之六至八成。
+ */
+template <std::size_t _WIDTH>
+PLATFORM_TARGET("avx512bw")
+static void swapAVX512(std::uint8_t* _target, \
+	const std::uint8_t* _source, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(__m512i);
+
+	auto mask = _mm512_loadu_si512(MASK<_WIDTH>.data());
+
+	decltype(_size) offset = 0;
+	for (; offset + BLOCK * 2 <= _size; offset += BLOCK * 2)
+	{
+		auto low = _mm512_loadu_si512(_source + offset);
+		auto high = _mm512_loadu_si512(_source + offset + BLOCK);
+		_mm512_storeu_si512(_target + offset, \
+			_mm512_shuffle_epi8(low, mask));
+		_mm512_storeu_si512(_target + offset + BLOCK, \
+			_mm512_shuffle_epi8(high, mask));
+	}
+
+	for (; offset + BLOCK <= _size; offset += BLOCK)
+	{
+		auto value = _mm512_loadu_si512(_source + offset);
+		_mm512_storeu_si512(_target + offset, \
+			_mm512_shuffle_epi8(value, mask));
+	}
+
+	// 掩码读写剩余字节，无需逐元素处理
+	if (auto size = _size - offset; size > 0)
+	{
+		auto bits = static_cast<__mmask64>((1ULL << size) - 1);
+		auto value = _mm512_maskz_loadu_epi8(bits, _source + offset);
+		_mm512_mask_storeu_epi8(_target + offset, bits, \
+			_mm512_shuffle_epi8(value, mask));
+	}
+}
+
+#elif defined(PLATFORM_NEON)
+template <std::size_t _WIDTH>
+static void swapNEON(std::uint8_t* _target, \
+	const std::uint8_t* _source, std::size_t _size) noexcept
+{
+	constexpr std::size_t BLOCK = sizeof(uint8x16_t);
+
+	decltype(_size) offset = 0;
+	for (; offset + BLOCK <= _size; offset += BLOCK)
+	{
+		auto value = vld1q_u8(_source + offset);
+		if constexpr (_WIDTH == sizeof(std::uint16_t))
+			value = vrev16q_u8(value);
+		else if constexpr (_WIDTH == sizeof(std::uint32_t))
+			value = vrev32q_u8(value);
+		else
+			value = vrev64q_u8(value);
+		vst1q_u8(_target + offset, value);
+	}
+
+	swapScalar<_WIDTH>(_target + offset, _source + offset, _size - offset);
+}
+#endif
+
+// 按处理器特性选择核心函数
+template <std::size_t _WIDTH>
+static Kernel select() noexcept
+{
+#if defined(PLATFORM_X86)
+	if (support(ISA_AVX512BW)) return swapAVX512<_WIDTH>;
+	if (support(ISA_AVX2)) return swapAVX2<_WIDTH>;
+	if (support(ISA_SSSE3)) return swapSSSE3<_WIDTH>;
+#elif defined(PLATFORM_NEON)
+	if (support(ISA_NEON)) return swapNEON<_WIDTH>;
+#endif
+	return swapScalar<_WIDTH>;
+}
+
+void byteswap(void* _target, const void* _source, \
+	std::size_t _size, std::size_t _width) noexcept
+{
+	auto target = static_cast<std::uint8_t*>(_target);
+	auto source = static_cast<const std::uint8_t*>(_source);
+	auto size = _size * _width;
+
+	switch (_width)
+	{
+	case sizeof(std::uint16_t):
+	{
+		static const auto kernel = select<sizeof(std::uint16_t)>();
+		kernel(target, source, size);
+		break;
+	}
+	case sizeof(std::uint32_t):
+	{
+		static const auto kernel = select<sizeof(std::uint32_t)>();
+		kernel(target, source, size);
+		break;
+	}
+	case sizeof(std::uint64_t):
+	{
+		static const auto kernel = select<sizeof(std::uint64_t)>();
+		kernel(target, source, size);
+		break;
+	}
+	default:
+		if (target != source)
+			std::memcpy(target, source, size);
+		break;
+	}
+}
+
+PLATFORM_SPACE_END
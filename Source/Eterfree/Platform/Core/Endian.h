@@ -1,113 +1,385 @@
 ﻿#pragma once
 
+#include <bit>
+#include <span>
+#include <array>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(_MSC_VER) and not defined(__clang__)
+#include <cstdlib>
+#endif
 
 #include "Common.h"
 
 PLATFORM_SPACE_BEGIN
 
 // 小端模式
-inline bool little() noexcept
+constexpr bool little() noexcept
+{
+	return std::endian::native == std::endian::little;
+}
+
+// 反转字节序，编译为单条字节交换指令
+template <std::unsigned_integral _Type>
+constexpr _Type byteswap(_Type _value) noexcept
+{
+#if defined(__cpp_lib_byteswap)
+	return std::byteswap(_value);
+#else
+	if constexpr (sizeof _value == sizeof(std::uint8_t))
+		return _value;
+
+#if defined(__GNUC__) or defined(__clang__)
+	else if constexpr (sizeof _value == sizeof(std::uint16_t))
+		return __builtin_bswap16(_value);
+	else if constexpr (sizeof _value == sizeof(std::uint32_t))
+		return __builtin_bswap32(_value);
+	else if constexpr (sizeof _value == sizeof(std::uint64_t))
+		return __builtin_bswap64(_value);
+#endif
+
+	else
+	{
+#if defined(_MSC_VER) and not defined(__clang__)
+		// 内部函数不可用于常量求值
+		if (not std::is_constant_evaluated())
+		{
+			if constexpr (sizeof _value == sizeof(unsigned short))
+				return _byteswap_ushort(_value);
+			else if constexpr (sizeof _value == sizeof(unsigned long))
+				return _byteswap_ulong(_value);
+			else if constexpr (sizeof _value == sizeof(unsigned __int64))
+				return _byteswap_uint64(_value);
+		}
+#endif
+
+		_Type value = 0;
+		for (auto index = sizeof _value; index > 0; --index)
+		{
+			value = static_cast<_Type>(value << 8 | (_value & 0xFF));
+			_value = static_cast<_Type>(_value >> 8);
+		}
+		return value;
+	}
+#endif
+}
+
+// 等宽无符号整数
+template <std::size_t _SIZE>
+struct Unsigned;
+
+template <>
+struct Unsigned<sizeof(std::uint8_t)> { using Type = std::uint8_t; };
+
+template <>
+struct Unsigned<sizeof(std::uint16_t)> { using Type = std::uint16_t; };
+
+template <>
+struct Unsigned<sizeof(std::uint32_t)> { using Type = std::uint32_t; };
+
+template <>
+struct Unsigned<sizeof(std::uint64_t)> { using Type = std::uint64_t; };
+
+// 主机字节序与网络字节序互相转换
+template <std::unsigned_integral _Type>
+constexpr _Type convert(_Type _value) noexcept
 {
-	constexpr auto INTEGER = static_cast<std::uint16_t>(1);
-	return *reinterpret_cast<const char*>(&INTEGER) != '\0';
+	if constexpr (std::endian::native == std::endian::big)
+		return _value;
+	else
+		return byteswap(_value);
 }
 
-inline std::uint8_t hton(std::uint8_t _value) noexcept
+constexpr std::uint8_t hton(std::uint8_t _value) noexcept
 {
 	return _value;
 }
 
-std::uint16_t hton(std::uint16_t _value);
+constexpr std::uint16_t hton(std::uint16_t _value) noexcept
+{
+	return convert(_value);
+}
 
-std::uint32_t hton(std::uint32_t _value);
+constexpr std::uint32_t hton(std::uint32_t _value) noexcept
+{
+	return convert(_value);
+}
 
-std::uint64_t hton(std::uint64_t _value);
+constexpr std::uint64_t hton(std::uint64_t _value) noexcept
+{
+	return convert(_value);
+}
 
-inline std::uint8_t hton(std::int8_t _value) noexcept
+constexpr std::uint8_t hton(std::int8_t _value) noexcept
 {
 	return static_cast<std::uint8_t>(_value);
 }
 
-inline std::uint16_t hton(std::int16_t _value)
+constexpr std::uint16_t hton(std::int16_t _value) noexcept
 {
 	return hton(static_cast<std::uint16_t>(_value));
 }
 
-inline std::uint32_t hton(std::int32_t _value)
+constexpr std::uint32_t hton(std::int32_t _value) noexcept
 {
 	return hton(static_cast<std::uint32_t>(_value));
 }
 
-inline std::uint64_t hton(std::int64_t _value)
+constexpr std::uint64_t hton(std::int64_t _value) noexcept
 {
 	return hton(static_cast<std::uint64_t>(_value));
 }
 
-inline std::uint8_t hton(bool _value) noexcept
+constexpr std::uint8_t hton(bool _value) noexcept
 {
 	return static_cast<std::uint8_t>(_value);
 }
 
-std::uint32_t hton(float _value);
+constexpr std::uint32_t hton(float _value) noexcept
+{
+	static_assert(sizeof _value == sizeof(std::uint32_t), \
+		"The size of float is not equal to the size of std::uint32_t.");
+	return hton(std::bit_cast<std::uint32_t>(_value));
+}
 
-std::uint64_t hton(double _value);
+constexpr std::uint64_t hton(double _value) noexcept
+{
+	static_assert(sizeof _value == sizeof(std::uint64_t), \
+		"The size of double is not equal to the size of std::uint64_t.");
+	return hton(std::bit_cast<std::uint64_t>(_value));
+}
 
 template <typename _Source, typename _Target>
-_Target ntoh(_Source _value);
+constexpr _Target ntoh(_Source _value) noexcept;
 
 template <>
-inline std::uint8_t ntoh(std::uint8_t _value)
+constexpr std::uint8_t ntoh(std::uint8_t _value) noexcept
 {
 	return _value;
 }
 
 template <>
-std::uint16_t ntoh(std::uint16_t _value);
+constexpr std::uint16_t ntoh(std::uint16_t _value) noexcept
+{
+	return convert(_value);
+}
 
 template <>
-std::uint32_t ntoh(std::uint32_t _value);
+constexpr std::uint32_t ntoh(std::uint32_t _value) noexcept
+{
+	return convert(_value);
+}
 
 template <>
-std::uint64_t ntoh(std::uint64_t _value);
+constexpr std::uint64_t ntoh(std::uint64_t _value) noexcept
+{
+	return convert(_value);
+}
 
 template <>
-inline std::int8_t ntoh(std::uint8_t _value)
+constexpr std::int8_t ntoh(std::uint8_t _value) noexcept
 {
 	return static_cast<std::int8_t>(_value);
 }
 
 template <>
-inline std::int16_t ntoh(std::uint16_t _value)
+constexpr std::int16_t ntoh(std::uint16_t _value) noexcept
 {
 	auto value = ntoh<std::uint16_t, std::uint16_t>(_value);
 	return static_cast<std::int16_t>(value);
 }
 
 template <>
-inline std::int32_t ntoh(std::uint32_t _value)
+constexpr std::int32_t ntoh(std::uint32_t _value) noexcept
 {
 	auto value = ntoh<std::uint32_t, std::uint32_t>(_value);
 	return static_cast<std::int32_t>(value);
 }
 
 template <>
-inline std::int64_t ntoh(std::uint64_t _value)
+constexpr std::int64_t ntoh(std::uint64_t _value) noexcept
 {
 	auto value = ntoh<std::uint64_t, std::uint64_t>(_value);
 	return static_cast<std::int64_t>(value);
 }
 
 template <>
-inline bool ntoh(std::uint8_t _value)
+constexpr bool ntoh(std::uint8_t _value) noexcept
 {
 	return static_cast<bool>(_value);
 }
 
 template <>
-float ntoh(std::uint32_t _value);
+constexpr float ntoh(std::uint32_t _value) noexcept
+{
+	auto value = ntoh<std::uint32_t, std::uint32_t>(_value);
+	return std::bit_cast<float>(value);
+}
 
 template <>
-double ntoh(std::uint64_t _value);
+constexpr double ntoh(std::uint64_t _value) noexcept
+{
+	auto value = ntoh<std::uint64_t, std::uint64_t>(_value);
+	return std::bit_cast<double>(value);
+}
+
+/*
+ * 按指定字节序存储之字段：以字节数组存储，对齐为一，可平凡复制，
+ * 读写时转换。可组成紧凑线上结构，直接覆盖于数据包内存，无需复制与对齐检查。
+ */
+template <typename _Type, std::endian _ORDER>
+class EndianValue final
+{
+	static_assert((std::is_arithmetic_v<_Type> or std::is_enum_v<_Type>) \
+		and not std::is_same_v<_Type, bool>, \
+		"The type is not an arithmetic or enumeration type.");
+
+	using Word = typename Unsigned<sizeof(_Type)>::Type;
+	using Bytes = std::array<unsigned char, sizeof(_Type)>;
+
+private:
+	Bytes _bytes;
+
+private:
+	static constexpr Word order(Word _word) noexcept
+	{
+		if constexpr (_ORDER == std::endian::native)
+			return _word;
+		else
+			return byteswap(_word);
+	}
+
+public:
+	// 自任意地址读取
+	static _Type read(const void* _data) noexcept
+	{
+		Word word;
+		std::memcpy(&word, _data, sizeof word);
+		return std::bit_cast<_Type>(order(word));
+	}
+
+	// 向任意地址写入
+	static void write(void* _data, _Type _value) noexcept
+	{
+		auto word = order(std::bit_cast<Word>(_value));
+		std::memcpy(_data, &word, sizeof word);
+	}
+
+public:
+	EndianValue() noexcept = default;
+
+	constexpr EndianValue(_Type _value) noexcept : \
+		_bytes(std::bit_cast<Bytes>(order(std::bit_cast<Word>(_value)))) {}
+
+	constexpr EndianValue& operator=(_Type _value) noexcept
+	{
+		store(_value);
+		return *this;
+	}
+
+	constexpr operator _Type() const noexcept
+	{
+		return load();
+	}
+
+	constexpr _Type load() const noexcept
+	{
+		return std::bit_cast<_Type>(order(std::bit_cast<Word>(_bytes)));
+	}
+
+	constexpr void store(_Type _value) noexcept
+	{
+		_bytes = std::bit_cast<Bytes>(order(std::bit_cast<Word>(_value)));
+	}
+
+	// 线上字节
+	const auto* data() const noexcept
+	{
+		return _bytes.data();
+	}
+};
+
+template <typename _Type>
+using BigEndian = EndianValue<_Type, std::endian::big>;
+
+template <typename _Type>
+using LittleEndian = EndianValue<_Type, std::endian::little>;
+
+template <typename _Type>
+using NativeEndian = EndianValue<_Type, std::endian::native>;
+
+// 可批量转换之元素类型
+template <typename _Type>
+concept Swappable = (std::unsigned_integral<_Type> \
+	or std::floating_point<_Type>) \
+	and (sizeof(_Type) == sizeof(std::uint16_t) \
+		or sizeof(_Type) == sizeof(std::uint32_t) \
+		or sizeof(_Type) == sizeof(std::uint64_t));
+
+/*
+ * 批量反转_size个宽度为_width字节之元素，运行时分派至AVX2、SSSE3或NEON实现。
+ * _target与_source相同则原地转换，否则不可重叠。
+ */
+void byteswap(void* _target, const void* _source, \
+	std::size_t _size, std::size_t _width) noexcept;
+
+// 批量转换之公共实现：字节序一致则原地转换为空操作，复制转换退化为复制
+template <typename _Source, typename _Target>
+std::size_t convert(_Source* _source, _Target* _target, \
+	std::size_t _size) noexcept
+{
+	static_assert(sizeof(_Source) == sizeof(_Target), \
+		"The size of source is not equal to the size of target.");
+
+	if constexpr (std::endian::native == std::endian::big)
+	{
+		if (static_cast<const void*>(_source) != _target)
+			std::memcpy(_target, _source, _size * sizeof(_Target));
+	}
+	else
+		byteswap(_target, _source, _size, sizeof(_Target));
+	return _size;
+}
+
+// 原地转换
+template <Swappable _Type, std::size_t _Extent>
+void hton(std::span<_Type, _Extent> _data) noexcept
+{
+	convert(_data.data(), _data.data(), _data.size());
+}
+
+template <Swappable _Type, std::size_t _Extent>
+void ntoh(std::span<_Type, _Extent> _data) noexcept
+{
+	convert(_data.data(), _data.data(), _data.size());
+}
+
+// 复制转换，返回转换的元素数量
+template <typename _Source, Swappable _Target, \
+	std::size_t _SourceExtent, std::size_t _TargetExtent> \
+	requires Swappable<std::remove_const_t<_Source>> \
+	and (sizeof(_Source) == sizeof(_Target))
+std::size_t hton(std::span<_Source, _SourceExtent> _source, \
+	std::span<_Target, _TargetExtent> _target) noexcept
+{
+	auto size = (std::min)(_source.size(), _target.size());
+	return convert(_source.data(), _target.data(), size);
+}
+
+template <typename _Source, Swappable _Target, \
+	std::size_t _SourceExtent, std::size_t _TargetExtent> \
+	requires Swappable<std::remove_const_t<_Source>> \
+	and (sizeof(_Source) == sizeof(_Target))
+std::size_t ntoh(std::span<_Source, _SourceExtent> _source, \
+	std::span<_Target, _TargetExtent> _target) noexcept
+{
+	auto size = (std::min)(_source.size(), _target.size());
+	return convert(_source.data(), _target.data(), size);
+}
 
 PLATFORM_SPACE_END